@@ -6,6 +6,11 @@ constexpr const char *SOCKET_PATH = "/run/linuxcampam/socket";
 constexpr const char *CONFIG_PATH = "/etc/linuxcampam/config.ini";
 constexpr const char *USERS_DIR = "/etc/linuxcampam/users";
 constexpr const char *MODELS_DIR = "/etc/linuxcampam/models";
+constexpr const char *CACHE_DIR = "/var/cache/linuxcampam";
+constexpr const char *PROBE_CACHE_PATH =
+    "/var/cache/linuxcampam/backend_probe.json";
+constexpr const char *CAMERA_HISTORY_PATH =
+    "/var/cache/linuxcampam/camera_history.json";
 constexpr const char *IR_EMITTER_PATH =
     "/usr/local/bin/linux-enable-ir-emitter";
 } // namespace linuxcampam
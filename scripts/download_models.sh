@@ -21,4 +21,19 @@ else
     echo "SFace model already exists and is valid, skipping download."
 fi
 
+# Optional int8 builds for low-end CPUs (select them in [Models])
+if [ "$1" = "--int8" ]; then
+    ZOO_URL="https://github.com/opencv/opencv_zoo/raw/main/models"
+    for model in face_detection_yunet/face_detection_yunet_2022mar_int8.onnx \
+                 face_recognition_sface/face_recognition_sface_2021dec_int8.onnx; do
+        name="$(basename "$model")"
+        echo "Downloading int8 model $name..."
+        if [ ! -s "$MODEL_DIR/$name" ]; then
+            wget -q --show-progress -O "$MODEL_DIR/$name" "$ZOO_URL/$model"
+        else
+            echo "$name already exists and is valid, skipping download."
+        fi
+    done
+fi
+
 echo "Models downloaded to $MODEL_DIR"
@@ -75,12 +75,15 @@ void print_help() {
       << "  linuxcampam test [username]             Test camera & auth\n"
       << "  linuxcampam list <username>             Show embedding labels\n"
       << "  linuxcampam remove <user> --label <X>   Remove specific embedding\n"
+      << "  linuxcampam status                      Show inference backend\n"
+      << "  linuxcampam memory                      Show daemon memory use\n"
       << "  linuxcampam help                        Show this help\n";
 }
 
 int main(int argc, char *argv[]) {
   if (argc < 2) {
-    std::cout << "Usage: linuxcampam <add|train|test|list|remove|help> [args]"
+    std::cout << "Usage: linuxcampam "
+                 "<add|train|test|list|remove|status|memory|help> [args]"
               << std::endl;
     return 1;
   }
@@ -219,6 +222,12 @@ int main(int argc, char *argv[]) {
     }
     print_response(send_cmd("REMOVE_EMBEDDING " + user + " " + label));
 
+  } else if (op == "status") {
+    print_response(send_cmd("STATUS"));
+
+  } else if (op == "memory") {
+    print_response(send_cmd("MEMORY"));
+
   } else if (op == "version" || op == "--version" || op == "-v") {
 #ifdef LINUXCAMPAM_VERSION
     std::cout << "Client Version: " << LINUXCAMPAM_VERSION << std::endl;
@@ -1,5 +1,6 @@
 
 #include "auth_engine.hpp"
+#include "bounded_queue.hpp"
 
 #include "camera.hpp"
 #include "constants.hpp"
@@ -7,14 +8,19 @@
 #include "logger.hpp"
 
 #include <algorithm>
+#include <cctype>
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <numeric>
 #include <opencv2/core/ocl.hpp>
 #include <regex>
 #include <sstream>
+#include <thread>
 #include <unordered_map>
 
 // V4L2 for camera format detection
@@ -27,17 +33,6 @@
 namespace fs = std::filesystem;
 using json = nlohmann::json;
 
-// Extract version from model filename (e.g. sface_2021dec)
-inline std::string getModelVersion(const std::string &model_path) {
-  fs::path p(model_path);
-  std::string filename = p.stem().string();
-  const std::string prefix = "face_recognition_";
-  if (filename.rfind(prefix, 0) == 0) {
-    return filename.substr(prefix.length());
-  }
-  return filename;
-}
-
 std::unordered_map<std::string, std::string>
 parse_ini(const std::string &path) {
   std::unordered_map<std::string, std::string> result;
@@ -152,6 +147,148 @@ std::vector<std::pair<std::string, std::string>> enumerateCameras() {
   return cameras;
 }
 
+// Read stored embeddings for a camera type (multi-format first, then legacy).
+// Entries whose size doesn't match the loaded recognizer (`dim`, 0 = any)
+// were enrolled with another model and are skipped.
+static std::vector<std::vector<float>>
+loadEmbeddings(const json &j, const std::string &type, int dim) {
+  std::vector<std::vector<float>> all_embeddings;
+  std::string emb_array_key = "embeddings_" + type;
+  std::string emb_key = "embedding_" + type;
+
+  if (j.contains(emb_array_key) && j[emb_array_key].is_array()) {
+    for (const auto &entry : j[emb_array_key]) {
+      if (entry.contains("data")) {
+        all_embeddings.push_back(entry["data"].get<std::vector<float>>());
+      }
+    }
+  } else if (j.contains(emb_key)) {
+    all_embeddings.push_back(j[emb_key].get<std::vector<float>>());
+  }
+
+  auto wrong_size = [dim](const std::vector<float> &v) {
+    return dim > 0 && static_cast<int>(v.size()) != dim;
+  };
+  size_t before = all_embeddings.size();
+  all_embeddings.erase(std::remove_if(all_embeddings.begin(),
+                                      all_embeddings.end(), wrong_size),
+                       all_embeddings.end());
+  if (all_embeddings.size() != before)
+    Logger::log(LogLevel::WARN,
+                std::to_string(before - all_embeddings.size()) + " " + type +
+                    " embedding(s) don't match the recognizer's size (" +
+                    std::to_string(dim) + "), re-enroll to use them.");
+  return all_embeddings;
+}
+
+// Highest cosine similarity between a feature and any stored embedding
+static float bestMatch(const cv::Mat &feature,
+                       const std::vector<std::vector<float>> &stored) {
+  float best = 0.0f;
+  for (const auto &stored_vec : stored) {
+    cv::Mat stored_emb(1, stored_vec.size(), CV_32F,
+                       const_cast<float *>(stored_vec.data()));
+    best = std::max(best, cosine_similarity(feature, stored_emb));
+  }
+  return best;
+}
+
+namespace {
+// Closes every camera stream opened during a verification on scope exit
+struct StreamGuard {
+  std::vector<Camera *> cams;
+  bool open(Camera *cam) {
+    if (!cam || !cam->openStream())
+      return false;
+    cams.push_back(cam);
+    return true;
+  }
+  ~StreamGuard() {
+    for (auto *cam : cams)
+      cam->closeStream();
+  }
+};
+
+// cv::setNumThreads for one pipeline stage (0 = leave OpenCV's setting)
+class StageThreads {
+public:
+  explicit StageThreads(int threads) : saved_(cv::getNumThreads()) {
+    if (threads > 0 && threads != saved_)
+      cv::setNumThreads(threads);
+    else
+      saved_ = 0;
+  }
+  ~StageThreads() {
+    if (saved_ > 0)
+      cv::setNumThreads(saved_);
+  }
+  StageThreads(const StageThreads &) = delete;
+  StageThreads &operator=(const StageThreads &) = delete;
+
+private:
+  int saved_;
+};
+
+// Capture stage of the verification pipeline: one thread per camera reads
+// up to `depth` frames ahead of detection, under the capture tuning. With
+// depth 0 next() reads on the calling thread instead.
+class CaptureStage {
+public:
+  CaptureStage(std::function<cv::Mat()> read,
+               std::function<std::unique_ptr<ThreadTuning>()> tuning,
+               size_t depth)
+      : read_(std::move(read)), tuning_(std::move(tuning)), queue_(depth) {
+    if (depth > 0)
+      thread_ = std::thread([this] {
+        auto tuning = tuning_();
+        cv::Mat frame;
+        do
+          frame = read_();
+        while (!frame.empty() && queue_.push(frame));
+        queue_.close();
+      });
+  }
+  ~CaptureStage() {
+    stop();
+    if (thread_.joinable())
+      thread_.join();
+  }
+  CaptureStage(const CaptureStage &) = delete;
+  CaptureStage &operator=(const CaptureStage &) = delete;
+
+  // Next frame, empty once the camera stopped delivering
+  cv::Mat next() {
+    if (!thread_.joinable()) {
+      auto tuning = tuning_();
+      return read_();
+    }
+    cv::Mat frame;
+    queue_.pop(frame);
+    return frame;
+  }
+  // Camera decided: stop reading ahead
+  void stop() { queue_.close(); }
+
+private:
+  std::function<cv::Mat()> read_;
+  std::function<std::unique_ptr<ThreadTuning>()> tuning_;
+  BoundedQueue<cv::Mat> queue_;
+  std::thread thread_;
+};
+
+// "auto" = fastest cores, otherwise a CPU list; empty = no pinning
+std::vector<int> resolveCpus(const std::string &setting, const char *key) {
+  if (setting.empty())
+    return {};
+  std::vector<int> cpus =
+      setting == "auto" ? fastestCpus() : parseCpuList(setting);
+  if (cpus.empty())
+    Logger::log(LogLevel::WARN,
+                std::string("Ignoring invalid ") + key + ": " + setting);
+  return cpus;
+}
+} // namespace
+
 AuthEngine::AuthEngine() {}
 AuthEngine::~AuthEngine() {}
 
@@ -179,6 +316,41 @@ bool AuthEngine::init(const std::string &config_path) {
     config.policy = AuthPolicy::ADAPTIVE;
 
   config.max_embeddings = std::stoi(get("Auth.max_embeddings", "5"));
+  config.max_faces = std::stoi(get("Auth.max_faces", "3"));
+  config.min_face_size = std::stof(get("Auth.min_face_size", "40"));
+
+  // Quality gate (0 disables an individual check)
+  config.quality_gate = (get("Quality.enabled", "on") == "on");
+  config.quality.min_sharpness = std::stof(get("Quality.min_sharpness", "10"));
+  config.quality.max_yaw_deg = std::stof(get("Quality.max_yaw", "35"));
+  config.quality.max_roll_deg = std::stof(get("Quality.max_roll", "25"));
+  config.quality.min_interocular_px =
+      std::stof(get("Quality.min_interocular", "20"));
+  config.quality.min_brightness =
+      std::stof(get("Quality.min_brightness", "25"));
+  config.quality.max_brightness =
+      std::stof(get("Quality.max_brightness", "235"));
+
+  config.score_fusion = (get("Fusion.enabled", "off") == "on");
+  config.score_model.genuine_mean =
+      std::stof(get("Fusion.genuine_mean", "0.60"));
+  config.score_model.genuine_std = std::stof(get("Fusion.genuine_std", "0.12"));
+  config.score_model.impostor_mean =
+      std::stof(get("Fusion.impostor_mean", "0.05"));
+  config.score_model.impostor_std =
+      std::stof(get("Fusion.impostor_std", "0.10"));
+  config.fusion_false_accept =
+      std::stod(get("Fusion.false_accept_rate", "0.0001"));
+  config.fusion_false_reject =
+      std::stod(get("Fusion.false_reject_rate", "0.001"));
+  // A zero spread makes every LLR NaN, and swapped means turn low scores
+  // into evidence for the user
+  if (config.score_fusion && !config.score_model.valid()) {
+    Logger::log(LogLevel::ERROR,
+                "Fusion calibration needs genuine_std and impostor_std > 0 "
+                "and genuine_mean > impostor_mean. Score fusion disabled.");
+    config.score_fusion = false;
+  }
 
   // Capture settings
   config.enroll_hdr = get("Capture.enroll_hdr", "auto");
@@ -188,6 +360,7 @@ bool AuthEngine::init(const std::string &config_path) {
   config.verify_averaging = (get("Capture.verify_averaging", "off") == "on");
   config.verify_average_frames =
       std::stoi(get("Capture.verify_average_frames", "3"));
+  config.ir_frame_sync = (get("Capture.ir_frame_sync", "on") == "on");
 
   // Parse Paths
   config.users_dir = get("Paths.users_dir", config.users_dir);
@@ -195,13 +368,17 @@ bool AuthEngine::init(const std::string &config_path) {
   config.ir_emitter_path =
       get("Paths.ir_emitter_path", linuxcampam::IR_EMITTER_PATH);
 
-  // Initialize model paths dynamic vars
-  // Note: If user supplies full path in config in future, handle that.
-  // For now assuming models_dir + filename.
-  detection_model_path =
-      config.models_dir + "/face_detection_yunet_2022mar.onnx";
-  recognition_model_path =
-      config.models_dir + "/face_recognition_sface_2021dec.onnx";
+  // Model files, precision and sizes from [Models] (bundled defaults)
+  models = ModelRegistry::fromConfig(get, config.models_dir);
+  std::string unsupported;
+  if (!models.recognition_fast.path.empty() &&
+      !models.recognition_fast.supported(unsupported)) {
+    Logger::log(LogLevel::WARN,
+                "Fast recognizer disabled, cascade off: " + unsupported);
+    models.recognition_fast.path.clear();
+  }
+  config.cascade_threshold = std::stof(get("Auth.cascade_threshold", "0.4"));
+  config.cascade_margin = std::stof(get("Auth.cascade_margin", "0.08"));
 
   // Parse Cameras
   std::string cam_names = get("Cameras.names", "");
@@ -231,6 +408,15 @@ bool AuthEngine::init(const std::string &config_path) {
           get("Camera." + id + ".enroll_average_frames", "0");
       def.enroll_average_frames = std::stoi(avg_frames);
 
+      // Detection resolution (0 = capture resolution)
+      def.detect_width = std::stoi(get("Camera." + id + ".detect_width", "0"));
+      def.detect_height =
+          std::stoi(get("Camera." + id + ".detect_height", "0"));
+      def.detect_max_side =
+          std::stoi(get("Camera." + id + ".detect_max_side", "0"));
+      def.detect_adaptive =
+          (get("Camera." + id + ".detect_adaptive", "false") == "true");
+
       config.camera_defs.push_back(def);
     }
   } else {
@@ -302,79 +488,406 @@ bool AuthEngine::init(const std::string &config_path) {
   std::string segment;
   while (std::getline(ss, segment, ',')) {
     segment.erase(0, segment.find_first_not_of(" \t"));
+    segment.erase(segment.find_last_not_of(" \t") + 1);
+    std::transform(segment.begin(), segment.end(), segment.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
     if (!segment.empty())
       config.provider_priority.push_back(segment);
   }
   if (config.provider_priority.empty())
-    config.provider_priority = {"OpenCL", "OpenVINO", "CUDA", "CPU"};
+    config.provider_priority = {"auto"};
 
   config.save_success = (get("Storage.save_success_images") == "true");
   config.save_fail = (get("Storage.save_fail_images") == "true");
 
   std::string ka_str = get("Performance.model_keep_alive_sec", "0");
   config.model_keep_alive_sec = std::stoi(ka_str);
+  config.unload_keep_buffers =
+      (get("Performance.unload_tier", "buffers") != "full");
+  config.memory_budget_mb =
+      std::max(0, std::stoi(get("Performance.memory_budget_mb", "0")));
+  config.trim_heap = (get("Performance.trim_heap", "on") == "on");
+  config.inference_cpus = get("Performance.inference_cpus", "");
+  config.capture_cpus = get("Performance.capture_cpus", "");
+  config.capture_priority =
+      parseSchedMode(get("Performance.capture_priority", "normal"));
+  config.thread_pool = (get("Performance.thread_pool", "on") == "on");
+  config.thread_pool_size =
+      std::max(0, std::stoi(get("Performance.thread_pool_size", "0")));
+  config.detect_threads =
+      std::max(0, std::stoi(get("Performance.detect_threads", "0")));
+  config.recognize_threads =
+      std::max(0, std::stoi(get("Performance.recognize_threads", "0")));
+  config.pipeline = (get("Performance.pipeline", "on") == "on");
+  config.pipeline_depth =
+      std::max(1, std::stoi(get("Performance.pipeline_depth", "2")));
+  config.learned_camera_order =
+      (get("Performance.camera_order", "learned") == "learned");
+  config.camera_history_path =
+      get("Performance.camera_history_path", config.camera_history_path);
+  if (config.learned_camera_order)
+    camera_history_.load(config.camera_history_path);
+  config.lock_memory = (get("Performance.lock_memory", "off") == "on");
+  config.lock_memory_max_mb =
+      std::max(1, std::stoi(get("Performance.lock_memory_max_mb", "256")));
+  config.pressure_eviction =
+      (get("Performance.eviction", "timer") == "pressure");
+  config.psi_path = get("Performance.psi_path", config.psi_path);
+  config.pressure_some_avg10 =
+      std::stod(get("Performance.pressure_some_avg10", "10"));
+  config.pressure_full_avg10 =
+      std::stod(get("Performance.pressure_full_avg10", "5"));
+  config.recognition_batch_size =
+      std::max(1, std::stoi(get("Performance.recognition_batch_size", "8")));
+  config.warmup = (get("Performance.warmup", "on") == "on");
+  config.inference_budget_ms =
+      std::stod(get("Performance.inference_budget_ms", "500"));
+  config.watchdog_strikes =
+      std::max(1, std::stoi(get("Performance.watchdog_strikes", "3")));
+  config.watchdog_reprobe_sec =
+      std::stoi(get("Performance.watchdog_reprobe_sec", "300"));
+  detect_watchdog_ =
+      InferenceWatchdog(config.inference_budget_ms, config.watchdog_strikes);
+  recognize_watchdog_ = detect_watchdog_;
+  config.opencl_cache_dir =
+      get("Performance.opencl_cache_dir", config.opencl_cache_dir);
+  config.batch_detection = (get("Performance.batch_detection", "on") == "on");
+  // YuNet strides go up to 32 px; keep the shared input size aligned to it
+  auto align32 = [](int v) { return std::max(32, (v + 31) / 32 * 32); };
+  const cv::Size det_input = models.detection.input_size;
+  config.batch_detect_size =
+      cv::Size(align32(std::stoi(get("Performance.batch_detect_width",
+                                     std::to_string(det_input.width)))),
+               align32(std::stoi(get("Performance.batch_detect_height",
+                                     std::to_string(det_input.height)))));
+  config.detector_cache_size =
+      std::max(1, std::stoi(get("Performance.detector_cache_size", "4")));
+  config.tracking = (get("Performance.tracking", "on") == "on");
+  config.track_redetect_frames =
+      std::stoi(get("Performance.track_redetect_frames", "5"));
+  config.track_min_confidence =
+      std::stof(get("Performance.track_min_confidence", "0.6"));
+  config.track_realign_ratio =
+      std::stof(get("Performance.track_realign_ratio", "0.05"));
+  config.detect_min_face_px =
+      std::stoi(get("Performance.detect_min_face_px", "64"));
+  config.two_stage_detection =
+      (get("Performance.two_stage_detection", "off") == "on");
+  config.coarse_detect_size =
+      cv::Size(std::stoi(get("Performance.coarse_detect_width", "160")),
+               std::stoi(get("Performance.coarse_detect_height", "120")));
+  int fine_side = std::stoi(get("Performance.fine_detect_size", "320"));
+  config.fine_detect_size = cv::Size(fine_side, fine_side);
+  // The batched pass letterboxes every frame to batch_detect_size, so it
+  // can't honor per-camera detection sizes or two-stage detection
+  if (config.batch_detection) {
+    std::string reason;
+    if (config.two_stage_detection)
+      reason = "two_stage_detection";
+    for (const auto &def : config.camera_defs) {
+      if (reason.empty() &&
+          ((def.detect_width > 0 && def.detect_height > 0) ||
+           def.detect_max_side > 0 || def.detect_adaptive))
+        reason = "Camera." + def.id + ".detect_*";
+    }
+    if (!reason.empty()) {
+      Logger::log(LogLevel::INFO,
+                  "Batched detection off: " + reason + " is set.");
+      config.batch_detection = false;
+    }
+  }
 
   last_activity_ = std::chrono::steady_clock::now();
 
+  // Inference placement is process-wide: OpenCV's worker threads (created
+  // on first use) and the warm-up thread inherit the main thread's mask
+  std::vector<int> inference_cpus =
+      resolveCpus(config.inference_cpus, "inference_cpus");
+  if (!inference_cpus.empty()) {
+    if (setThreadAffinity(inference_cpus))
+      Logger::log(LogLevel::INFO, "Inference pinned to CPUs " +
+                                      formatCpuList(inference_cpus));
+    else
+      Logger::log(LogLevel::WARN, "Could not pin inference to CPUs " +
+                                      formatCpuList(inference_cpus));
+  }
+  capture_cpus_ = resolveCpus(config.capture_cpus, "capture_cpus");
+
+  // After pinning, so the workers inherit the inference CPU set. Created
+  // once: OpenCV keeps the backend for the life of the process.
+  if (config.thread_pool && !pool_) {
+    auto pool = std::make_shared<ThreadPool>(config.thread_pool_size);
+    if (installParallelBackend(pool)) {
+      pool_ = pool;
+      Logger::log(LogLevel::INFO, "OpenCV parallel_for runs on " +
+                                      std::to_string(pool_->size()) +
+                                      " pool workers.");
+    } else {
+      Logger::log(LogLevel::INFO, "OpenCV too old for a custom parallel "
+                                  "backend, thread_pool ignored.");
+    }
+  }
+
+  // Everything anonymous allocated after this point is model memory
+  if (config.lock_memory && baseline_maps_.empty())
+    baseline_maps_ = readMaps();
+  locker_.setCap(static_cast<size_t>(config.lock_memory_max_mb) << 20);
+
+  pressure_.reset();
+  if (config.pressure_eviction) {
+    auto monitor = std::make_unique<MemoryPressureMonitor>(
+        config.psi_path, cgroupMemoryEventsPath(), config.pressure_some_avg10,
+        config.pressure_full_avg10);
+    if (monitor->available())
+      pressure_ = std::move(monitor);
+    else
+      Logger::log(LogLevel::WARN, config.psi_path +
+                                      " not readable (kernel without PSI?), "
+                                      "using model_keep_alive_sec.");
+  }
+
+  // Before anything touches OpenCL (provider selection in loadModels)
+  configureOpenCLCache();
+
   // 2. Initialize Models (Delegated)
   return loadModels();
 }
 
+void AuthEngine::configureOpenCLCache() {
+  if (config.opencl_cache_dir.empty())
+    return; // OpenCV default (~/.cache/opencv)
+  std::error_code ec;
+  fs::create_directories(config.opencl_cache_dir, ec);
+  if (ec) {
+    Logger::log(LogLevel::WARN, "OpenCL cache dir " + config.opencl_cache_dir +
+                                    " unavailable: " + ec.message());
+    return;
+  }
+  chmod(config.opencl_cache_dir.c_str(), 0700);
+  // Read by OpenCV when the first OpenCL program is built; an explicit
+  // environment setting wins
+  setenv("OPENCV_OPENCL_CACHE_DIR", config.opencl_cache_dir.c_str(), 0);
+}
+
+void AuthEngine::warmUp() {
+  ThreadPool::PriorityScope background(ThreadPool::Priority::LOW);
+  const auto start = std::chrono::steady_clock::now();
+  try {
+    // Detector: every input size the cameras used before an unload, or the
+    // configured per-camera detection size on a fresh start
+    std::vector<cv::Size> sizes = warm_sizes_;
+    if (sizes.empty()) {
+      for (const auto &def : config.camera_defs) {
+        if (def.detect_width > 0 && def.detect_height > 0)
+          sizes.emplace_back(def.detect_width, def.detect_height);
+        else
+          sizes.emplace_back(640, 480);
+      }
+    }
+    std::sort(sizes.begin(), sizes.end(), [](cv::Size a, cv::Size b) {
+      return std::make_pair(a.width, a.height) <
+             std::make_pair(b.width, b.height);
+    });
+    sizes.erase(std::unique(sizes.begin(), sizes.end()), sizes.end());
+    cv::Mat faces;
+    for (const auto &size : sizes)
+      detector->detect(cv::Mat(size, CV_8UC3, cv::Scalar::all(128)), faces);
+
+    if (batch_detector) {
+      std::vector<cv::Mat> frames(config.camera_defs.size(),
+                                  cv::Mat(config.batch_detect_size, CV_8UC3,
+                                          cv::Scalar::all(128)));
+      std::vector<cv::Mat> batch_faces;
+      (void)batch_detector->detect(frames, batch_faces);
+    }
+
+    // Recognizers: single crop and a batch as large as one step usually is
+    const size_t batch = std::min<size_t>(
+        config.recognition_batch_size,
+        std::max<size_t>(1, config.camera_defs.size()));
+    std::vector<cv::Mat> features;
+    for (size_t n : {size_t(1), batch}) {
+      std::vector<cv::Mat> crops(
+          n, cv::Mat(112, 112, CV_8UC3, cv::Scalar::all(128)));
+      extractFeatures(*recognizer, recognizer_net, batch_recognition_ok_,
+                      models.recognition.input_size, crops, features);
+      if (fast_recognizer)
+        extractFeatures(*fast_recognizer, fast_recognizer_net, fast_batch_ok_,
+                        models.recognition_fast.input_size, crops, features);
+      if (batch == 1)
+        break;
+    }
+  } catch (const cv::Exception &e) {
+    Logger::log(LogLevel::WARN, "Warm-up failed: " + std::string(e.what()));
+    return;
+  }
+  auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start)
+                .count();
+  Logger::log(LogLevel::INFO, "Models warmed up in " + std::to_string(ms) +
+                                  " ms.");
+  // After the warm-up so its blobs are allocated (and locked) too
+  lockMemory();
+}
+
+void AuthEngine::lockMemory() {
+  if (!config.lock_memory)
+    return;
+  locker_.unlockAll();
+  size_t n = locker_.lock(grownRegions(baseline_maps_, readMaps()));
+  if (locker_.limited()) {
+    // Root (the shipped unit) has CAP_IPC_LOCK, so RLIMIT_MEMLOCK only
+    // holds back non-root runs
+    std::string why;
+    if (locker_.error() == 0)
+      why = "lock_memory_max_mb reached";
+    else if (geteuid() != 0)
+      why = "over RLIMIT_MEMLOCK (ulimit -l)";
+    else
+      why = std::string("mlock: ") + std::strerror(locker_.error());
+    Logger::log(LogLevel::WARN,
+                "Locked only " + formatBytes(n) + " of model memory: " + why);
+  } else
+    Logger::log(LogLevel::INFO, "Locked " + formatBytes(n) + " in RAM.");
+}
+
+void AuthEngine::waitForWarmup() {
+  if (warmup_.valid())
+    warmup_.get();
+}
+
+void AuthEngine::selectProvider(int &backend_id, int &target_id) {
+  BackendCandidate chosen = providerCandidates("cpu").front();
+  // Reloaded after an unload while the watchdog holds us on the CPU
+  for (const auto &prov : config.provider_priority) {
+    if (cpu_fallback_)
+      break;
+    if (prov == "auto") {
+      if (const ProbeResult *best = probeProviders())
+        chosen = {best->name, best->backend_id, best->target_id};
+      break;
+    }
+    auto candidates = providerCandidates(prov);
+    auto it = std::find_if(candidates.begin(), candidates.end(),
+                           isBackendAvailable);
+    if (it != candidates.end()) {
+      chosen = *it;
+      break;
+    }
+    Logger::log(LogLevel::WARN,
+                prov + " requested but not available. Trying next provider.");
+  }
+
+  backend_ = chosen;
+  backend_id = chosen.backend_id;
+  target_id = chosen.target_id;
+  std::cout << "[AuthEngine] Selecting " << chosen.name << " Backend."
+            << std::endl;
+  if (target_id == cv::dnn::DNN_TARGET_OPENCL ||
+      target_id == cv::dnn::DNN_TARGET_OPENCL_FP16) {
+    cv::ocl::setUseOpenCL(true);
+    // Log the OpenCL device name for assurance
+    cv::ocl::Device dev = cv::ocl::Device::getDefault();
+    std::cout << "[AuthEngine] Hardware Device: " << dev.name() << " "
+              << dev.version() << std::endl;
+  }
+}
+
+const ProbeResult *AuthEngine::probeProviders() {
+  const std::string key = probeKey(models.detection, models.recognition);
+  // Keep-alive and pressure reloads reuse the report already in memory
+  if (probe_report_.key != key) {
+    if (!loadProbeReport(config.probe_cache_path, key, probe_report_)) {
+      // Once per process: if the report can't be saved, later reloads
+      // must not benchmark again inside a PAM request
+      if (probe_benchmarked_)
+        return nullptr;
+      for (const ModelSpec *spec : {&models.detection, &models.recognition}) {
+        std::string reason;
+        if (!spec->supported(reason))
+          return nullptr; // Reported by loadModels
+      }
+      Logger::log(LogLevel::INFO, "Benchmarking inference backends...");
+      probe_benchmarked_ = true;
+      probe_report_ = probeBackends(models.detection, models.recognition,
+                                    availableBackends());
+      if (!saveProbeReport(config.probe_cache_path, probe_report_))
+        Logger::log(LogLevel::WARN,
+                    "Cannot write " + config.probe_cache_path);
+    }
+
+    for (const auto &r : probe_report_.results) {
+      std::ostringstream line;
+      line << std::fixed << std::setprecision(2) << r.name << ": ";
+      if (r.ok)
+        line << r.detect_ms << " ms detect, " << r.recognize_ms
+             << " ms recognize";
+      else
+        line << "unusable (" << r.error << ")";
+      Logger::log(LogLevel::INFO, line.str());
+    }
+  }
+
+  const ProbeResult *best = probe_report_.best();
+  // Drivers can disappear after the report was written
+  if (best && !isBackendAvailable({best->name, best->backend_id,
+                                   best->target_id})) {
+    Logger::log(LogLevel::WARN, best->name + " no longer available.");
+    return nullptr;
+  }
+  return best;
+}
+
 bool AuthEngine::loadModels() {
   if (detector && recognizer)
     return true; // Already loaded
 
-  // Re-parse backend config in case priority changed or dynamic re-eval needed?
-  // For now assuming config.provider_priority is static after init.
   int backend_id = cv::dnn::DNN_BACKEND_OPENCV;
   int target_id = cv::dnn::DNN_TARGET_CPU;
+  selectProvider(backend_id, target_id);
 
-  for (const auto &prov : config.provider_priority) {
-    if (prov == "CUDA") {
-      if (cv::cuda::getCudaEnabledDeviceCount() > 0) {
-        backend_id = cv::dnn::DNN_BACKEND_CUDA;
-        target_id = cv::dnn::DNN_TARGET_CUDA;
-        std::cout << "[AuthEngine] Selecting CUDA Backend." << std::endl;
-        break;
-      }
-    } else if (prov == "OpenVINO") {
-      backend_id = cv::dnn::DNN_BACKEND_INFERENCE_ENGINE;
-      target_id = cv::dnn::DNN_TARGET_CPU;
-      std::cout << "[AuthEngine] Selecting OpenVINO Backend." << std::endl;
-      break;
-    } else if (prov == "OpenCL") {
-      if (cv::ocl::haveOpenCL()) {
-        cv::ocl::setUseOpenCL(true);
-        backend_id = cv::dnn::DNN_BACKEND_OPENCV;
-        target_id = cv::dnn::DNN_TARGET_OPENCL;
-        std::cout << "[AuthEngine] Selecting OpenCL Backend." << std::endl;
-        // Log the OpenCL device name for assurance
-        cv::ocl::Device dev = cv::ocl::Device::getDefault();
-        std::cout << "[AuthEngine] Hardware Device: " << dev.name() << " "
-                  << dev.version() << std::endl;
-      } else {
-        std::cerr << "[AuthEngine] WARNING: OpenCL requested but not "
-                     "detected. Falling back to CPU."
-                  << std::endl;
-        backend_id = cv::dnn::DNN_BACKEND_OPENCV;
-        target_id = cv::dnn::DNN_TARGET_CPU;
-      }
-      break;
+  for (const ModelSpec *spec : {&models.detection, &models.recognition}) {
+    std::string reason;
+    if (!spec->supported(reason)) {
+      Logger::log(LogLevel::ERROR, "Cannot load model: " + reason);
+      return false;
     }
   }
 
+  const auto load_start = std::chrono::steady_clock::now();
+  const bool from_memory = !buffers_.empty();
+  ProcessMemory rss_before;
+  (void)readProcessMemory(rss_before);
+  // Pressure eviction may have dropped only the recognizers
+  const bool need_detector = !detector;
   try {
-    std::cout << "[AuthEngine] Loading Detector: " << detection_model_path
-              << std::endl;
-    std::cout << "[AuthEngine] Loading Recognizer: " << recognition_model_path
+    if (need_detector)
+      std::cout << "[AuthEngine] Loading Detector: " << models.detection.path
+                << " (" << precisionName(models.detection.precision) << ")"
+                << std::endl;
+    std::cout << "[AuthEngine] Loading Recognizer: " << models.recognition.path
+              << " (" << precisionName(models.recognition.precision) << ")"
               << std::endl;
 
-    detector = cv::FaceDetectorYN::create(
-        detection_model_path, "", cv::Size(320, 320),
-        config.detection_threshold, 0.3f, 5000, backend_id, target_id);
+    if (need_detector)
+      detector = makeDetector(backend_id, target_id);
+
+    if (!makeRecognizer(backend_id, target_id, recognizer, recognizer_net,
+                        batch_recognition_ok_)) {
+      detector.reset();
+      recognizer.release();
+      recognizer_net = cv::dnn::Net();
+      return false;
+    }
 
-    recognizer = cv::FaceRecognizerSF::create(recognition_model_path, "",
-                                              backend_id, target_id);
+    loadFastRecognizer(backend_id, target_id);
+
+    if (need_detector && config.batch_detection &&
+        config.camera_defs.size() > 1) {
+      batch_detector = makeBatchDetector(backend_id, target_id);
+      batch_detection_ok_ = true;
+    }
+    buffers_.clear();
 
     // Cameras are lightweight, "active_cameras" structs can be maintained,
     // but maybe camera connection should be re-verified?
@@ -389,6 +902,7 @@ bool AuthEngine::loadModels() {
                                         def.type + ") at " + def.path);
         ac.cam = std::make_unique<Camera>(def.path, def.type == "ir",
                                           config.ir_emitter_path);
+        ac.cam->setEmitterSync(config.ir_frame_sync);
         active_cameras.push_back(std::move(ac));
       }
     }
@@ -398,21 +912,98 @@ bool AuthEngine::loadModels() {
     return false;
   }
 
+  last_load_ms_ = std::chrono::duration<double, std::milli>(
+                      std::chrono::steady_clock::now() - load_start)
+                      .count();
+  last_load_from_memory_ = from_memory;
+  ProcessMemory rss_after;
+  if (need_detector && rss_before.rss_anon > 0 &&
+      readProcessMemory(rss_after) && rss_after.rss_anon > rss_before.rss_anon)
+    model_rss_ = rss_after.rss_anon - rss_before.rss_anon;
+  Logger::log(LogLevel::INFO,
+              "Models ready in " +
+                  std::to_string(static_cast<int>(last_load_ms_)) + " ms" +
+                  (from_memory ? " (from memory)." : " (from disk)."));
+
+  updateFramePipeline();
+  if (config.warmup)
+    warmup_ = std::async(std::launch::async, [this] { warmUp(); });
+  else
+    lockMemory();
+
   last_activity_ = std::chrono::steady_clock::now();
   return true;
 }
 
 void AuthEngine::unloadModels() {
+  waitForWarmup();
   if (detector) {
+    warm_sizes_ = detector->sizes();
     Logger::log(LogLevel::INFO, "Unloading AI models to save RAM.");
-    detector.release();
+    locker_.unlockAll(); // Locked pages can't be trimmed
+    detector.reset();
     recognizer.release();
+    recognizer_net = cv::dnn::Net();
+    batch_detector.reset();
+    fast_recognizer.release();
+    fast_recognizer_net = cv::dnn::Net();
+    // Lowest tier: a few MB of ONNX bytes instead of the initialized graphs,
+    // so waking up skips the disk (and, with a cold page cache, the seeks)
+    if (config.unload_keep_buffers) {
+      if (buffers_.read(models))
+        Logger::log(LogLevel::INFO,
+                    "Keeping " + std::to_string(buffers_.bytes() >> 10) +
+                        " KiB of model data for a fast reload.");
+      else
+        Logger::log(LogLevel::WARN, "Could not buffer model files.");
+    }
+    reclaimHeap();
+    lockMemory(); // The model bytes kept for the reload
   }
   // Optional: cv::cuda::resetDevice()? Usually not safe if multi-threaded.
 }
 
+bool AuthEngine::evict(PressureLevel level) {
+  waitForWarmup();
+  // Under pressure nothing stays pinned; the kernel may need those pages
+  locker_.unlockAll();
+  bool released = false;
+  // Recognizers first: the SFace graphs are the largest, and without them
+  // the detector still skips its own re-initialization on the next request
+  if (recognizer) {
+    recognizer.release();
+    recognizer_net = cv::dnn::Net();
+    fast_recognizer.release();
+    fast_recognizer_net = cv::dnn::Net();
+    released = true;
+  }
+  if (level >= PressureLevel::MEDIUM && detector) {
+    warm_sizes_ = detector->sizes();
+    detector.reset();
+    batch_detector.reset();
+    released = true;
+  }
+  // Buffers already held stay for a fast reload below CRITICAL, but none
+  // are read here: that would allocate what the eviction just freed. The
+  // next idle unload (unloadModels) fills them again.
+  if (level >= PressureLevel::CRITICAL) {
+    released = released || !buffers_.empty();
+    buffers_.clear();
+  }
+  if (released) {
+    reclaimHeap();
+    const PsiSample &psi = pressure_->last();
+    Logger::log(LogLevel::INFO,
+                std::string("Memory pressure ") + pressureLevelName(level) +
+                    " (some " + std::to_string(psi.some.avg10) + "%, full " +
+                    std::to_string(psi.full.avg10) + "%): released " +
+                    (detector ? "recognizer." : "models."));
+  }
+  return released;
+}
+
 bool AuthEngine::ensureModelsLoaded() {
-  if (!detector) {
+  if (!detector || !recognizer) {
     Logger::log(LogLevel::INFO, "Wake up! Reloading models...");
     return loadModels();
   }
@@ -421,7 +1012,37 @@ bool AuthEngine::ensureModelsLoaded() {
   return true;
 }
 
+void AuthEngine::reclaimHeap() {
+  if (!config.trim_heap)
+    return;
+  size_t released = trimHeap();
+  if (released > 0)
+    Logger::log(LogLevel::INFO,
+                "Returned " + formatBytes(released) + " of heap to the OS.");
+}
+
+bool AuthEngine::overMemoryBudget() const {
+  ProcessMemory mem;
+  return config.memory_budget_mb > 0 && readProcessMemory(mem) &&
+         mem.rss > static_cast<size_t>(config.memory_budget_mb) << 20;
+}
+
 bool AuthEngine::performMaintenance() {
+  if (cpu_fallback_)
+    checkFallbackRecovery();
+  if ((detector || recognizer) && overMemoryBudget()) {
+    Logger::log(LogLevel::WARN, "Over memory_budget_mb (" +
+                                    std::to_string(config.memory_budget_mb) +
+                                    " MiB), unloading models.");
+    unloadModels();
+    return true;
+  }
+  // Pressure-driven eviction replaces the idle timer: with headroom the
+  // models stay loaded however long the daemon is idle
+  if (pressure_) {
+    pressure_level_ = pressure_->poll();
+    return pressure_level_ != PressureLevel::NONE && evict(pressure_level_);
+  }
   // Check if unload is needed
   // TODO: maybe add configurable grace period?
   if (config.model_keep_alive_sec > 0 && detector) {
@@ -437,21 +1058,226 @@ bool AuthEngine::performMaintenance() {
   return false;
 }
 
-void AuthEngine::fallbackToCPU() {
-  Logger::log(LogLevel::WARN, "Attempting fallback to CPU backend...");
+void AuthEngine::runWatched(InferenceWatchdog &watchdog,
+                            const std::string &stage, int threads,
+                            const std::function<void()> &run) {
+  ThreadPool::PriorityScope critical(ThreadPool::Priority::HIGH);
+  settleStage(watchdog, stage, timeStage(threads, run), run);
+}
+
+AuthEngine::StageRun AuthEngine::timeStage(int threads,
+                                           const std::function<void()> &run) {
+  StageThreads stage_threads(threads);
+  StageRun result;
+  result.accelerated = acceleratedBackend();
+  const auto start = std::chrono::steady_clock::now();
+  try {
+    run();
+  } catch (...) {
+    result.error = std::current_exception();
+  }
+  result.ms = std::chrono::duration<double, std::milli>(
+                  std::chrono::steady_clock::now() - start)
+                  .count();
+  return result;
+}
+
+void AuthEngine::settleStage(InferenceWatchdog &watchdog,
+                             const std::string &stage, const StageRun &result,
+                             const std::function<void()> &run) {
+  if (result.error) {
+    try {
+      std::rethrow_exception(result.error);
+    } catch (const cv::Exception &e) {
+      watchdog.fail();
+      if (!result.accelerated)
+        throw; // Nothing left to fall back to
+      // The concurrent stage may have fallen back already
+      if (acceleratedBackend())
+        fallbackToCPU(stage + " failed on " + backend_.name + ": " + e.what());
+      run(); // Same frames again, now on the CPU
+    }
+    return;
+  }
+  if (watchdog.record(result.ms) && result.accelerated &&
+      acceleratedBackend()) {
+    std::ostringstream reason;
+    reason << stage << " over " << watchdog.budget() << " ms "
+           << watchdog.strikes() << " times in a row on " << backend_.name;
+    fallbackToCPU(reason.str());
+  }
+}
+
+void AuthEngine::fallbackToCPU(const std::string &reason) {
+  Logger::log(LogLevel::WARN,
+              reason + ". Attempting fallback to CPU backend...");
+  const BackendCandidate from = backend_;
+  if (!switchBackend(providerCandidates("cpu").front()))
+    return;
+  cpu_fallback_ = true;
+  fallback_from_ = from;
+  fallback_reason_ = reason;
+  fallback_since_ = last_reprobe_ = std::chrono::steady_clock::now();
+  Logger::log(LogLevel::INFO, "Successfully switched to CPU backend.");
+}
+
+bool AuthEngine::switchBackend(const BackendCandidate &to) {
+  waitForWarmup();
   try {
-    detector = cv::FaceDetectorYN::create(
-        detection_model_path, "", cv::Size(320, 320),
-        config.detection_threshold, 0.3f, 5000, cv::dnn::DNN_BACKEND_OPENCV,
-        cv::dnn::DNN_TARGET_CPU);
-    recognizer = cv::FaceRecognizerSF::create(recognition_model_path, "",
-                                              cv::dnn::DNN_BACKEND_OPENCV,
-                                              cv::dnn::DNN_TARGET_CPU);
-    Logger::log(LogLevel::INFO, "Successfully switched to CPU backend.");
+    // Only what is loaded: pressure eviction may have dropped the
+    // recognizers and kept the detector
+    std::unique_ptr<DetectorCache> new_detector;
+    if (detector)
+      new_detector = makeDetector(to.backend_id, to.target_id);
+    std::unique_ptr<BatchFaceDetector> new_batch;
+    if (batch_detector)
+      new_batch = makeBatchDetector(to.backend_id, to.target_id);
+    cv::Ptr<cv::FaceRecognizerSF> new_recognizer;
+    cv::dnn::Net new_net;
+    bool new_batch_ok = true;
+    if (recognizer && !makeRecognizer(to.backend_id, to.target_id,
+                                      new_recognizer, new_net, new_batch_ok)) {
+      Logger::log(LogLevel::ERROR, "Failed to switch to " + to.name +
+                                       " backend: recognizer rejected.");
+      return false;
+    }
+
+    if (new_detector)
+      detector = std::move(new_detector);
+    if (new_recognizer) {
+      recognizer = new_recognizer;
+      recognizer_net = new_net;
+      batch_recognition_ok_ = new_batch_ok;
+    }
+    if (new_batch) {
+      batch_detector = std::move(new_batch);
+      batch_detection_ok_ = true;
+    }
+    if (fast_recognizer)
+      loadFastRecognizer(to.backend_id, to.target_id);
   } catch (const cv::Exception &e) {
-    Logger::log(LogLevel::ERROR,
-                "Failed to switch to CPU backend: " + std::string(e.what()));
+    Logger::log(LogLevel::ERROR, "Failed to switch to " + to.name +
+                                     " backend: " + std::string(e.what()));
+    return false;
+  }
+  backend_ = to;
+  updateFramePipeline();
+  detect_watchdog_.reset();
+  recognize_watchdog_.reset();
+  return true;
+}
+
+void AuthEngine::checkFallbackRecovery() {
+  const auto now = std::chrono::steady_clock::now();
+  if (reprobe_.valid()) {
+    if (reprobe_.wait_for(std::chrono::seconds(0)) !=
+        std::future_status::ready)
+      return;
+    ProbeReport report = reprobe_.get();
+    last_reprobe_ = now;
+    const ProbeResult *best = report.best();
+    if (!best || best->backend_id != fallback_from_.backend_id ||
+        best->target_id != fallback_from_.target_id) {
+      auto it = std::find_if(
+          report.results.begin(), report.results.end(),
+          [this](const ProbeResult &r) {
+            return r.backend_id == fallback_from_.backend_id &&
+                   r.target_id == fallback_from_.target_id;
+          });
+      std::ostringstream why;
+      why << std::fixed << std::setprecision(1);
+      if (it == report.results.end())
+        why << "not probed";
+      else if (!it->ok)
+        why << "still failing: " << it->error;
+      else if (best)
+        why << "works but slower than " << best->name << " ("
+            << it->totalMs() << " vs " << best->totalMs() << " ms)";
+      else
+        why << "no CPU reference to check it against";
+      Logger::log(LogLevel::INFO, fallback_from_.name + " " + why.str() +
+                                      ", staying on CPU.");
+      return;
+    }
+    // Models unloaded meanwhile: the next load picks the backend again
+    if ((detector || recognizer) && !switchBackend(fallback_from_))
+      return;
+    cpu_fallback_ = false;
+    Logger::log(LogLevel::INFO, fallback_from_.name + " backend restored.");
+    if (detector && recognizer && config.warmup)
+      warmup_ = std::async(std::launch::async, [this] { warmUp(); });
+    return;
   }
+
+  if (config.watchdog_reprobe_sec <= 0 ||
+      now - last_reprobe_ < std::chrono::seconds(config.watchdog_reprobe_sec))
+    return;
+  Logger::log(LogLevel::INFO, "Re-probing " + fallback_from_.name + "...");
+  // Plain thread: a driver that hangs again must not block the daemon
+  // (a std::async future would join in its destructor)
+  std::packaged_task<ProbeReport()> task(
+      [det = models.detection, rec = models.recognition,
+       candidates = std::vector<BackendCandidate>{
+           providerCandidates("cpu").front(), fallback_from_}] {
+        ThreadPool::PriorityScope background(ThreadPool::Priority::LOW);
+        return probeBackends(det, rec, candidates, 3);
+      });
+  reprobe_ = task.get_future();
+  std::thread(std::move(task)).detach();
+}
+
+std::string AuthEngine::statusReport() const {
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(1) << "Backend: " << backend_.name;
+  if (cpu_fallback_) {
+    auto since = std::chrono::duration_cast<std::chrono::seconds>(
+                     std::chrono::steady_clock::now() - fallback_since_)
+                     .count();
+    out << " (fallback from " << fallback_from_.name << " " << since
+        << " s ago: " << fallback_reason_;
+    if (reprobe_.valid())
+      out << "; re-probe running";
+    out << ")";
+  }
+  out << " | Models: " << (detector ? "loaded" : "unloaded")
+      << " | Detect: " << detect_watchdog_.median()
+      << " ms | Recognize: " << recognize_watchdog_.median()
+      << " ms | Budget: " << config.inference_budget_ms << " ms";
+  if (pressure_)
+    out << " | Memory pressure: " << pressureLevelName(pressure_level_);
+  if (last_load_ms_ > 0.0)
+    out << " | Last load: " << last_load_ms_ << " ms"
+        << (last_load_from_memory_ ? " (memory)" : " (disk)");
+  for (const auto &ac : active_cameras) {
+    const CameraStats *s = camera_history_.find(ac.config.id);
+    if (s && s->attempts > 0)
+      out << " | " << ac.config.id << ": " << s->successes << "/"
+          << s->attempts << " matched, " << s->medianLatency() << " ms";
+  }
+  return out.str();
+}
+
+std::string AuthEngine::memoryReport() const {
+  ProcessMemory mem;
+  (void)readProcessMemory(mem);
+  HeapStats heap = heapStats();
+  std::ostringstream out;
+  out << "RSS: " << formatBytes(mem.rss) << " (anon "
+      << formatBytes(mem.rss_anon) << ", file " << formatBytes(mem.rss_file)
+      << ", locked " << formatBytes(mem.locked) << ")";
+  if (config.memory_budget_mb > 0)
+    out << " | Budget: " << config.memory_budget_mb << " MiB";
+  out << " | Models: ";
+  if (detector && recognizer)
+    out << formatBytes(model_rss_);
+  else
+    out << (detector || recognizer ? "partial" : "unloaded");
+  out << " | Model files: " << formatBytes(buffers_.bytes())
+      << " | Frames: " << formatBytes(frame_bytes_);
+  if (heap.valid)
+    out << " | Heap: " << formatBytes(heap.in_use) << " used, "
+        << formatBytes(heap.free) << " free";
+  return out.str();
 }
 
 bool AuthEngine::isValidUsername(const std::string &username) {
@@ -464,186 +1290,685 @@ bool AuthEngine::isValidUsername(const std::string &username) {
   return std::regex_match(username, re);
 }
 
+std::unique_ptr<ThreadTuning> AuthEngine::captureTuning() {
+  if (capture_cpus_.empty() && config.capture_priority == SchedMode::NORMAL)
+    return nullptr;
+  auto tuning =
+      std::make_unique<ThreadTuning>(capture_cpus_, config.capture_priority);
+  // Capture threads of several cameras may get here at once
+  if (!tuning->ok() && !capture_tuning_warned_.exchange(true))
+    Logger::log(LogLevel::WARN, "capture_cpus/capture_priority not fully "
+                                "applied (CPUs offline or no CAP_SYS_NICE).");
+  return tuning;
+}
+
+cv::Mat AuthEngine::readCameraFrame(Camera *cam) {
+  auto tuning = captureTuning();
+  return cam->readFrame();
+}
+
 cv::Mat AuthEngine::captureFrame(Camera *cam) {
   if (!cam)
     return cv::Mat();
+  auto tuning = captureTuning();
   return cam->capture();
 }
 
-double AuthEngine::calculateBrightness(const cv::Mat &frame) {
-  if (frame.empty())
-    return 0.0;
-  cv::Scalar means = cv::mean(frame);
-  return (means[0] + means[1] + means[2]) / 3.0;
+double AuthEngine::calculateBrightness(cv::InputArray frame) {
+  return meanBrightness(frame);
 }
 
-bool AuthEngine::verifyUser(const std::string &username) {
-  if (!ensureModelsLoaded()) {
-    std::cerr << "[AuthEngine] CRITICAL: Failed to load models!" << std::endl;
-    return false;
+void AuthEngine::updateFramePipeline() {
+  use_umat_ = (backend_.target_id == cv::dnn::DNN_TARGET_OPENCL ||
+               backend_.target_id == cv::dnn::DNN_TARGET_OPENCL_FP16) &&
+              cv::ocl::useOpenCL();
+  for (auto &ac : active_cameras)
+    ac.cam->setUseUMat(use_umat_);
+  if (use_umat_ && batch_detector)
+    Logger::log(LogLevel::INFO, "OpenCL frame pipeline: batched detection "
+                                "off, detecting per camera.");
+}
+
+float AuthEngine::detectionScale(const ActiveCamera &ac,
+                                 cv::Size frame_size) const {
+  const auto &def = ac.config;
+  float scale = 1.0f;
+  if (def.detect_width > 0 && def.detect_height > 0) {
+    scale = std::min(static_cast<float>(def.detect_width) / frame_size.width,
+                     static_cast<float>(def.detect_height) / frame_size.height);
   }
-  if (!isValidUsername(username)) {
-    std::cerr << "[AuthEngine] Security Warn: Invalid username string: "
-              << username << std::endl;
-    return false;
+  if (def.detect_max_side > 0) {
+    int max_side = std::max(frame_size.width, frame_size.height);
+    scale = std::min(scale, static_cast<float>(def.detect_max_side) / max_side);
   }
-  std::string user_file =
-      std::string(config.users_dir) + "/" + username + ".json";
-  if (!fs::exists(user_file))
-    return false;
 
-  std::ifstream f(user_file);
-  json j;
-  f >> j;
+  // Adaptive: smallest scale at which the last matched face still spans
+  // detect_min_face_px. Quantized to 1/8 steps so the detector cache only
+  // ever sees a handful of input sizes.
+  if (def.detect_adaptive && ac.last_face_px > 0.0f &&
+      config.detect_min_face_px > 0) {
+    float needed = config.detect_min_face_px / ac.last_face_px;
+    needed = std::ceil(needed * 8.0f) / 8.0f;
+    scale = std::min(scale, std::max(needed, 0.125f));
+  }
+  return std::min(scale, 1.0f);
+}
 
-  int participants = 0;
-  int successes = 0;
-  int failures = 0;
+void AuthEngine::detectFaces(const ActiveCamera &ac, cv::InputArray frame,
+                             cv::Mat &faces) {
+  if (config.two_stage_detection) {
+    // Letterboxes ROIs on the host
+    detectCoarseToFine(*detector, frame.getMat(), config.coarse_detect_size,
+                       config.fine_detect_size, 1.6f, 0.3f, faces);
+    return;
+  }
 
-  Logger::log(LogLevel::INFO, "Verifying user " + username + " with policy " +
-                                  std::to_string((int)config.policy));
+  float scale = detectionScale(ac, frame.size());
+  if (scale >= 1.0f) {
+    detector->detect(frame, faces);
+    return;
+  }
 
-  for (auto &ac : active_cameras) {
-    std::string id = ac.config.id;
-    // Capture
-    cv::Mat frame = captureFrame(ac.cam.get());
+  // Same buffer kind as the frame, so a UMat is resized on the device
+  auto detectScaled = [&](auto small) {
+    cv::resize(frame, small, cv::Size(), scale, scale, cv::INTER_AREA);
+    detector->detect(small, faces);
+    // Landmarks back to full resolution so alignCrop sees full-res pixels
+    rescaleFaces(faces, static_cast<float>(small.cols) / frame.size().width);
+  };
+  if (frame.isUMat())
+    detectScaled(cv::UMat());
+  else
+    detectScaled(cv::Mat());
+}
 
-    // Participation Check
-    if (frame.empty()) {
-      std::cout << "[AuthEngine] Camera " << id << " failed to capture."
-                << std::endl;
-      if (config.policy == AuthPolicy::STRICT_ALL)
-        return false;
-      if (config.policy == AuthPolicy::ADAPTIVE && ac.config.mandatory) {
+void AuthEngine::detectFrames(std::vector<CameraFrame *> &frames) {
+  frame_bytes_ = 0;
+  for (const auto *cf : frames)
+    frame_bytes_ += cf->frame.total() * cf->frame.elemSize() +
+                    cf->uframe.total() * cf->uframe.elemSize();
+  // The batch is built from host frames; the OpenCL pipeline keeps them on
+  // the device per camera
+  if (frames.size() > 1 && batch_detector && batch_detection_ok_ &&
+      !use_umat_) {
+    std::vector<cv::Mat> images;
+    for (const auto *cf : frames)
+      images.push_back(cf->frame);
+    std::vector<cv::Mat> faces;
+    if (batch_detector->detect(images, faces)) {
+      for (size_t i = 0; i < frames.size(); i++) {
+        if (!cv::checkRange(faces[i]))
+          CV_Error(cv::Error::StsOutOfRange, "non-finite detector output");
+        frames[i]->faces = faces[i];
+      }
+      return;
+    }
+    Logger::log(LogLevel::WARN, "Batched detection unsupported by model, "
+                                "detecting per camera.");
+    batch_detection_ok_ = false; // Don't retry on every request
+  }
+
+  for (auto *cf : frames) {
+    detectFaces(*cf->ac, cf->image(), cf->faces);
+  }
+  // A broken GPU driver tends to produce garbage rather than an error
+  for (const auto *cf : frames) {
+    if (!cv::checkRange(cf->faces))
+      CV_Error(cv::Error::StsOutOfRange, "non-finite detector output");
+  }
+}
+
+std::unique_ptr<DetectorCache> AuthEngine::makeDetector(int backend_id,
+                                                        int target_id) const {
+  models.detection.selectBackend(backend_id, target_id);
+  return std::make_unique<DetectorCache>(
+      models.detection.path, config.detection_threshold, 0.3f, 5000,
+      backend_id, target_id, config.detector_cache_size, buffers_.detection);
+}
+
+std::unique_ptr<BatchFaceDetector>
+AuthEngine::makeBatchDetector(int backend_id, int target_id) const {
+  models.detection.selectBackend(backend_id, target_id);
+  return std::make_unique<BatchFaceDetector>(
+      models.detection.path, config.batch_detect_size,
+      config.detection_threshold, 0.3f, 5000, backend_id, target_id,
+      buffers_.detection);
+}
+
+bool AuthEngine::makeRecognizer(int backend_id, int target_id,
+                                cv::Ptr<cv::FaceRecognizerSF> &sf,
+                                cv::dnn::Net &net, bool &batch_ok) {
+  models.recognition.selectBackend(backend_id, target_id);
+  sf = createRecognizer(models.recognition.path, buffers_.recognition,
+                        backend_id, target_id);
+  // Second handle on the SFace graph for batched inference; the
+  // FaceRecognizerSF API only accepts one crop per forward pass.
+  net = readModelNet(models.recognition.path, buffers_.recognition);
+  net.setPreferableBackend(backend_id);
+  net.setPreferableTarget(target_id);
+  batch_ok = true;
+  return checkEmbeddingSize(models.recognition, *sf, net, batch_ok);
+}
+
+void AuthEngine::loadFastRecognizer(int backend_id, int target_id) {
+  fast_recognizer.release();
+  fast_recognizer_net = cv::dnn::Net();
+  const ModelSpec &spec = models.recognition_fast;
+  if (spec.path.empty())
+    return;
+  std::cout << "[AuthEngine] Loading Fast Recognizer: " << spec.path << " ("
+            << precisionName(spec.precision) << ")" << std::endl;
+  spec.selectBackend(backend_id, target_id);
+  fast_recognizer = createRecognizer(spec.path, buffers_.recognition_fast,
+                                     backend_id, target_id);
+  fast_recognizer_net = readModelNet(spec.path, buffers_.recognition_fast);
+  fast_recognizer_net.setPreferableBackend(backend_id);
+  fast_recognizer_net.setPreferableTarget(target_id);
+  fast_batch_ok_ = true;
+
+  if (!checkEmbeddingSize(models.recognition_fast, *fast_recognizer,
+                          fast_recognizer_net, fast_batch_ok_)) {
+    Logger::log(LogLevel::WARN, "Recognizer cascade disabled.");
+    fast_recognizer.release();
+    fast_recognizer_net = cv::dnn::Net();
+  }
+}
+
+bool AuthEngine::checkEmbeddingSize(ModelSpec &spec, cv::FaceRecognizerSF &sf,
+                                    cv::dnn::Net &net, bool &batch_ok) {
+  // One dummy crop through the model; also catches input size mistakes
+  std::vector<cv::Mat> probe{cv::Mat(112, 112, CV_8UC3, cv::Scalar::all(128))};
+  std::vector<cv::Mat> out;
+  extractFeatures(sf, net, batch_ok, spec.input_size, probe, out);
+  const int dim = static_cast<int>(out[0].total());
+  if (spec.embedding_dim > 0 && dim != spec.embedding_dim) {
+    Logger::log(LogLevel::ERROR,
+                spec.path + " produces " + std::to_string(dim) +
+                    "-d embeddings, config expects " +
+                    std::to_string(spec.embedding_dim));
+    return false;
+  }
+  spec.embedding_dim = dim;
+  return true;
+}
+
+bool AuthEngine::embed(const cv::Mat &aligned, std::vector<float> &vec) {
+  std::vector<cv::Mat> features;
+  extractFeatures(*recognizer, recognizer_net, batch_recognition_ok_,
+                  models.recognition.input_size, {aligned}, features);
+  features[0].reshape(1, 1).copyTo(vec);
+  return true;
+}
+
+bool AuthEngine::fastFeature(const cv::Mat &aligned, std::vector<float> &vec) {
+  if (!fast_recognizer)
+    return false;
+  std::vector<cv::Mat> features;
+  extractFeatures(*fast_recognizer, fast_recognizer_net, fast_batch_ok_,
+                  models.recognition_fast.input_size, {aligned}, features);
+  features[0].reshape(1, 1).copyTo(vec);
+  return true;
+}
+
+void AuthEngine::extractFeatures(cv::FaceRecognizerSF &sf, cv::dnn::Net &net,
+                                 bool &batch_ok, cv::Size input_size,
+                                 const std::vector<cv::Mat> &aligned,
+                                 std::vector<cv::Mat> &features) {
+  features.assign(aligned.size(), cv::Mat());
+  const size_t batch = static_cast<size_t>(config.recognition_batch_size);
+
+  for (size_t start = 0; start < aligned.size(); start += batch) {
+    const size_t end = std::min(aligned.size(), start + batch);
+    const int n = static_cast<int>(end - start);
+    bool batched = false;
+
+    if (n > 1 && batch_ok && !net.empty()) {
+      try {
+        std::vector<cv::Mat> chunk(aligned.begin() + start,
+                                   aligned.begin() + end);
+        // Same preprocessing as FaceRecognizerSF::feature(), stacked NCHW
+        cv::Mat blob = cv::dnn::blobFromImages(
+            chunk, 1.0, input_size, cv::Scalar(0, 0, 0), true, false);
+        net.setInput(blob);
+        cv::Mat out = net.forward();
+        if (!out.empty() && out.total() % n == 0) {
+          out = out.reshape(1, n);
+          for (int i = 0; i < n; i++)
+            features[start + i] = out.row(i).clone();
+          batched = true;
+        }
+      } catch (const cv::Exception &e) {
         Logger::log(LogLevel::WARN,
-                    "Critical Mandatory Camera " + id + " failed. Abort.");
-        return false;
+                    "Batched recognition unsupported by model, using "
+                    "per-face inference: " +
+                        std::string(e.what()));
       }
-      continue;
+      if (!batched)
+        batch_ok = false; // Don't retry on every request
     }
 
-    if (ac.config.min_brightness > 0) {
-      double b = calculateBrightness(frame);
-      if (b < ac.config.min_brightness) {
-        if (config.policy == AuthPolicy::ADAPTIVE && ac.config.mandatory) {
-          Logger::log(LogLevel::WARN,
-                      "Mandatory Camera " + id + " is too dark (" +
-                          std::to_string(b) + " < " +
-                          std::to_string(ac.config.min_brightness) +
-                          "). Failing.");
-          return false;
+    if (!batched) {
+      for (size_t i = start; i < end; i++) {
+        // FaceRecognizerSF is fixed to SFace's 112x112 input
+        if (input_size == cv::Size(112, 112) || net.empty()) {
+          sf.feature(aligned[i], features[i]);
+          continue;
         }
-        Logger::log(LogLevel::DEBUG,
-                    "Camera " + id + " too dark (" + std::to_string(b) + " < " +
-                        std::to_string(ac.config.min_brightness) +
-                        "). Skipping.");
-        continue;
+        net.setInput(cv::dnn::blobFromImage(aligned[i], 1.0, input_size,
+                                            cv::Scalar(0, 0, 0), true, false));
+        features[i] = net.forward().clone();
       }
     }
+  }
+  for (const auto &f : features) {
+    if (!cv::checkRange(f))
+      CV_Error(cv::Error::StsOutOfRange, "non-finite embedding");
+  }
+}
 
-    participants++;
+void AuthEngine::rankFaces(cv::Mat &faces) const {
+  std::vector<int> idx;
+  for (int i = 0; i < faces.rows; i++) {
+    // Too small to be the person sitting at the machine (poster, background)
+    if (std::min(faces.at<float>(i, 2), faces.at<float>(i, 3)) <
+        config.min_face_size)
+      continue;
+    idx.push_back(i);
+  }
 
-    // Load embeddings (multi-format first, then legacy)
-    std::string emb_array_key = "embeddings_" + ac.config.type;
-    std::string emb_key = "embedding_" + ac.config.type;
+  // Operator first: biggest box weighted by detection confidence
+  auto rank = [&faces](int i) {
+    return faces.at<float>(i, 2) * faces.at<float>(i, 3) *
+           faces.at<float>(i, 14);
+  };
+  std::stable_sort(idx.begin(), idx.end(),
+                   [&rank](int a, int b) { return rank(a) > rank(b); });
+  if (config.max_faces > 0 &&
+      idx.size() > static_cast<size_t>(config.max_faces))
+    idx.resize(config.max_faces);
+
+  cv::Mat ranked;
+  for (int i : idx)
+    ranked.push_back(faces.row(i));
+  faces = ranked;
+}
 
-    std::vector<std::vector<float>> all_embeddings;
+bool AuthEngine::gateFaces(CameraFrame &cf) {
+  if (!config.quality_gate)
+    return true;
+  cv::Mat kept;
+  for (int i = 0; i < cf.faces.rows; i++) {
+    FaceQuality q = assessFaceQuality(cf.frame, cf.faces.row(i));
+    std::string issue = checkFaceQuality(q, config.quality);
+    if (issue.empty()) {
+      kept.push_back(cf.faces.row(i));
+    } else {
+      cf.quality_issue = issue;
+      Logger::log(LogLevel::DEBUG, cf.ac->config.id + " skipping face: " +
+                                       issue + " (sharpness " +
+                                       std::to_string(q.sharpness) + ", yaw " +
+                                       std::to_string(q.yaw_deg) + ")");
+    }
+  }
+  cf.faces = kept;
+  if (kept.empty())
+    cf.low_quality_frames++;
+  return !kept.empty();
+}
 
-    if (j.contains(emb_array_key) && j[emb_array_key].is_array()) {
-      for (const auto &entry : j[emb_array_key]) {
-        if (entry.contains("data")) {
-          all_embeddings.push_back(entry["data"].get<std::vector<float>>());
+void AuthEngine::scoreFrames(std::vector<CameraFrame *> &frames) {
+  std::vector<CameraFrame *> pending;
+  for (auto *cf : frames) {
+    cf->scored = false;
+    if (cf->faces.empty())
+      continue;
+    // Tracked face with (almost) the same alignment as the last recognized
+    // one: SFace would see the same crop, so keep the previous score.
+    if (cf->tracked && alignmentChange(cf->scored_face, cf->faces.row(0)) <
+                           config.track_realign_ratio)
+      continue;
+    // Blurred, turned or badly lit faces would only burn a recognizer pass
+    if (!gateFaces(*cf))
+      continue;
+    cf->frame_score = 0.0f;
+    cf->scored = true;
+    cf->scored_face = cf->faces.row(0).clone();
+    pending.push_back(cf);
+  }
+
+  // Faces are ranked (rankFaces), so round r recognizes the r-th candidate of
+  // every camera in one batch. A camera drops out as soon as one of its faces
+  // clears the threshold; the remaining candidates are never recognized.
+  for (int round = 0; !pending.empty(); round++) {
+    std::vector<cv::Mat> aligned;
+    std::vector<CameraFrame *> owner;
+    for (auto *cf : pending) {
+      cv::Mat crop;
+      alignFace(*recognizer, cf->image(), cf->faces.row(round), crop);
+      aligned.push_back(crop);
+      owner.push_back(cf);
+    }
+
+    // Cascade: the fast model settles clear accepts and rejects; only
+    // faces within cascade_margin of its threshold reach the full model.
+    // Fusion is calibrated on full-model scores, so it bypasses the cascade.
+    std::vector<float> scores(owner.size(), 0.0f);
+    std::vector<bool> settled(owner.size(), false);
+    if (fast_recognizer && !config.score_fusion) {
+      std::vector<cv::Mat> fast_in, fast_features;
+      std::vector<size_t> fast_idx;
+      for (size_t k = 0; k < owner.size(); k++) {
+        if (owner[k]->fast_embeddings.empty())
+          continue;
+        fast_in.push_back(aligned[k]);
+        fast_idx.push_back(k);
+      }
+      extractFeatures(*fast_recognizer, fast_recognizer_net, fast_batch_ok_,
+                      models.recognition_fast.input_size, fast_in,
+                      fast_features);
+      for (size_t i = 0; i < fast_idx.size(); i++) {
+        size_t k = fast_idx[i];
+        auto &cf = *owner[k];
+        float s = bestMatch(fast_features[i], cf.fast_embeddings);
+        cf.fast_score = std::max(cf.fast_score, s);
+        if (std::abs(s - config.cascade_threshold) <= config.cascade_margin)
+          continue;
+        settled[k] = true;
+        cf.fast_decisions++;
+        if (s > config.cascade_threshold && !cf.fast_matched) {
+          cf.fast_matched = true;
+          cf.best_face = cf.faces.row(round).clone();
         }
       }
-    } else if (j.contains(emb_key)) {
-      all_embeddings.push_back(j[emb_key].get<std::vector<float>>());
     }
 
-    if (all_embeddings.empty()) {
-      Logger::log(LogLevel::WARN, "No embeddings found for " + ac.config.type);
-      failures++;
-      if (config.save_fail)
-        cv::imwrite(config.log_dir + "fail_missing_" + id + "_" + username +
-                        ".jpg",
-                    frame);
-      continue;
+    std::vector<cv::Mat> full_in, features;
+    std::vector<size_t> full_idx;
+    for (size_t k = 0; k < owner.size(); k++) {
+      if (settled[k])
+        continue;
+      full_in.push_back(aligned[k]);
+      full_idx.push_back(k);
+    }
+    extractFeatures(*recognizer, recognizer_net, batch_recognition_ok_,
+                    models.recognition.input_size, full_in, features);
+    // Compare each face against ALL stored embeddings of its camera
+    for (size_t i = 0; i < full_idx.size(); i++) {
+      size_t k = full_idx[i];
+      scores[k] = bestMatch(features[i], owner[k]->embeddings);
     }
 
-    // Detect faces
-    cv::Mat faces;
-    detector->setInputSize(frame.size());
-    detector->detect(frame, faces);
-
-    bool match = false;
-    if (faces.rows >= 1) {
-      cv::Mat aligned_face, curr_emb;
-      float best_score = 0.0f;
-
-      // For each detected face, compare against ALL stored embeddings
-      for (int i = 0; i < faces.rows; i++) {
-        recognizer->alignCrop(frame, faces.row(i), aligned_face);
-        recognizer->feature(aligned_face, curr_emb);
-
-        for (const auto &stored_vec : all_embeddings) {
-          cv::Mat stored_emb(1, stored_vec.size(), CV_32F,
-                             const_cast<float *>(stored_vec.data()));
-          float score = cosine_similarity(curr_emb, stored_emb);
-          if (score > best_score)
-            best_score = score;
-        }
+    for (size_t k = 0; k < owner.size(); k++) {
+      auto &cf = *owner[k];
+      if (settled[k])
+        continue;
+      if (scores[k] > cf.frame_score)
+        cf.frame_score = scores[k];
+      if (scores[k] > cf.best_score) {
+        cf.best_score = scores[k];
+        cf.best_face = cf.faces.row(round).clone();
       }
+    }
 
-      Logger::log(LogLevel::INFO,
-                  id + " Score: " + std::to_string(best_score) +
-                      " (threshold: " + std::to_string(config.threshold) +
-                      ", embeddings: " + std::to_string(all_embeddings.size()) +
-                      ")");
-      if (best_score >= config.threshold) {
-        match = true;
-        Logger::log(LogLevel::INFO, id + " MATCH.");
-      } else {
-        Logger::log(LogLevel::INFO, id + " MISMATCH: score below threshold.");
+    std::vector<CameraFrame *> next;
+    for (auto *cf : pending) {
+      if (cf->frame_score < config.threshold && !cf->fast_matched &&
+          round + 1 < cf->faces.rows)
+        next.push_back(cf);
+    }
+    pending.swap(next);
+  }
+}
+
+std::vector<AuthEngine::CameraFrame *>
+AuthEngine::trackFrames(std::vector<CameraFrame *> &frames) {
+  // Track where possible, run full detection only every
+  // track_redetect_frames frames or when the tracker loses the face
+  std::vector<CameraFrame *> to_detect;
+  for (auto *cf : frames) {
+    cf->tracked = false;
+    if (config.tracking && cf->tracker.active() &&
+        cf->frames_since_detect < config.track_redetect_frames) {
+      cv::Mat face;
+      if (cf->tracker.update(cf->frame, face)) {
+        cf->faces = face;
+        cf->tracked = true;
+        cf->frames_since_detect++;
       }
+    }
+    if (!cf->tracked)
+      to_detect.push_back(cf);
+  }
+  return to_detect;
+}
+
+void AuthEngine::finishDetection(std::vector<CameraFrame *> &detected) {
+  for (auto *cf : detected) {
+    cf->frames_since_detect = 0;
+    rankFaces(cf->faces);
+    if (cf->faces.rows > 0) {
+      cf->any_face = true;
+      if (config.tracking)
+        cf->tracker.init(cf->frame, cf->faces.row(0));
     } else {
-      Logger::log(LogLevel::WARN, id + " NO_FACE_DETECTED in frame.");
+      cf->tracker.reset();
     }
+  }
+}
 
-    if (match) {
-      successes++;
-      if (config.save_success)
-        cv::imwrite(config.log_dir + "success_" + id + "_" + username + ".jpg",
-                    frame);
+void AuthEngine::verifyFrames(std::vector<CameraFrame> &step) {
+  // Cameras are already streaming, so their start-up overlapped the warm-up
+  waitForWarmup();
+  ThreadPool::PriorityScope critical(ThreadPool::Priority::HIGH);
+  const auto start = std::chrono::steady_clock::now();
+  const auto deadline = start + std::chrono::milliseconds(config.timeout_ms);
+  auto elapsed = [&start] {
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+  };
+
+  // Score fusion: strict/adaptive need every camera to match, so each runs
+  // its own sequential test; lenient accepts on any camera, so evidence from
+  // all cameras is pooled into one test.
+  const bool pooled =
+      config.score_fusion && config.policy == AuthPolicy::LENIENT_ANY;
+  SequentialTest pool(config.score_model, config.fusion_false_accept,
+                      config.fusion_false_reject);
+  for (auto &cf : step)
+    cf.evidence = pool;
+
+  // Pipelined, detection and recognition run at the same time, so OpenCV's
+  // global thread count can't be set per stage
+  const int detect_threads = config.pipeline ? 0 : config.detect_threads;
+  const int recognize_threads = config.pipeline ? 0 : config.recognize_threads;
+  std::vector<std::unique_ptr<CaptureStage>> capture;
+  for (auto &cf : step) {
+    Camera *cam = cf.ac->cam.get();
+    capture.push_back(std::make_unique<CaptureStage>(
+        [cam] { return cam->readFrame(); }, [this] { return captureTuning(); },
+        config.pipeline ? config.pipeline_depth : 0));
+  }
+  auto undecided = [](const CameraFrame &cf) {
+    return !cf.matched && !cf.exhausted && !cf.rejected;
+  };
+  bool cancelled = false;
+
+  std::vector<CameraFrame *> active;
+  for (auto &cf : step) {
+    if (undecided(cf))
+      active.push_back(&cf);
+  }
+  std::vector<CameraFrame *> to_detect = trackFrames(active);
+  runWatched(detect_watchdog_, "Detection", detect_threads,
+             [&] { detectFrames(to_detect); });
+  finishDetection(to_detect);
+
+  while (!active.empty()) {
+    // Recognition works on a snapshot of the step, so the cameras can move
+    // on to their next frame meanwhile
+    std::vector<CameraFrame> snapshot;
+    snapshot.reserve(active.size());
+    for (auto *cf : active) {
+      snapshot.push_back(*cf);
+      snapshot.back().embeddings = std::move(cf->embeddings);
+      snapshot.back().fast_embeddings = std::move(cf->fast_embeddings);
+    }
+    // A failed pass may have updated part of the snapshot (scored_face,
+    // counters), so the CPU retry must not see its leftovers
+    auto recognize = [&] {
+      commitOnSuccess(snapshot, [this](std::vector<CameraFrame> &work) {
+        std::vector<CameraFrame *> scoring;
+        for (auto &cf : work)
+          scoring.push_back(&cf);
+        scoreFrames(scoring);
+      });
+    };
+
+    // Next frame of every camera still running, tracked or detected
+    std::vector<CameraFrame *> next;
+    to_detect.clear();
+    StageRun detection;
+    auto advance = [&] {
+      if (std::chrono::steady_clock::now() >= deadline)
+        return;
+      for (auto *cf : active) {
+        if (!undecided(*cf))
+          continue;
+        cv::Mat frame = capture[cf - step.data()]->next();
+        if (frame.empty()) {
+          cf->exhausted = true;
+          cf->decide_ms = elapsed();
+          continue;
+        }
+        cf->setFrame(frame, use_umat_);
+        next.push_back(cf);
+      }
+      to_detect = trackFrames(next);
+      detection = timeStage(detect_threads, [&] { detectFrames(to_detect); });
+    };
+
+    StageRun recognition;
+    if (config.pipeline) {
+      // Speculative: a camera may be decided by the frame being recognized,
+      // which wastes that camera's next detection
+      auto pending = std::async(std::launch::async, [&] {
+        ThreadPool::PriorityScope critical(ThreadPool::Priority::HIGH);
+        return timeStage(recognize_threads, recognize);
+      });
+      advance();
+      recognition = pending.get();
     } else {
-      failures++;
-      if (config.save_fail)
-        cv::imwrite(config.log_dir + "fail_" + id + "_" + username + ".jpg",
-                    frame);
+      recognition = timeStage(recognize_threads, recognize);
+    }
+    settleStage(recognize_watchdog_, "Recognition", recognition, recognize);
+
+    for (size_t i = 0; i < active.size(); i++) {
+      auto *cf = active[i];
+      cf->takeScores(snapshot[i]);
+      cf->frames_seen++;
+      if (!config.score_fusion) {
+        cf->matched = cf->best_score >= config.threshold || cf->fast_matched;
+      } else if (cf->scored) {
+        // Tracked frames that kept their previous score add no new evidence
+        FusionDecision d = cf->evidence.add(cf->frame_score);
+        if (pooled) {
+          pool.add(cf->frame_score);
+        } else {
+          cf->matched = (d == FusionDecision::ACCEPT);
+          cf->rejected = (d == FusionDecision::REJECT);
+        }
+      }
+      if (cf->matched || cf->rejected) {
+        cf->decide_ms = elapsed();
+        capture[cf - step.data()]->stop();
+        // Keep the frame that decided it (saved by save_success/save_fail)
+        cf->frame = snapshot[i].frame;
+        cf->uframe = snapshot[i].uframe;
+        cf->faces = snapshot[i].faces;
+      }
+    }
+
+    if (pooled && pool.decision() != FusionDecision::CONTINUE) {
+      if (pool.decision() == FusionDecision::ACCEPT) {
+        auto best = std::max_element(step.begin(), step.end(),
+                                     [](const auto &a, const auto &b) {
+                                       return a.best_score < b.best_score;
+                                     });
+        best->matched = true;
+        best->decide_ms = elapsed();
+      }
+      return;
+    }
+
+    // Outcome fixed: stop the other cameras, dropping their speculative
+    // next step
+    if (policyDecided(step)) {
+      Logger::log(LogLevel::DEBUG, "Policy outcome decided after " +
+                                       std::to_string(int(elapsed())) +
+                                       " ms, cancelling remaining cameras.");
+      cancelled = true;
+      break;
+    }
+
+    if (!config.pipeline)
+      advance();
+    if (!next.empty())
+      settleStage(detect_watchdog_, "Detection", detection,
+                  [&] { detectFrames(to_detect); });
+    finishDetection(to_detect);
+
+    active.clear();
+    for (auto *cf : next) {
+      if (undecided(*cf))
+        active.push_back(cf);
     }
   }
 
-  if (participants == 0) {
-    Logger::log(LogLevel::WARN, "No cameras verified (all failed or skipped).");
-    return false;
+  // Still undecided at the deadline: fall back to the single-frame threshold
+  if (config.score_fusion) {
+    for (auto &cf : step) {
+      if (pooled || cf.evidence.decision() == FusionDecision::CONTINUE)
+        cf.matched = (cf.best_score >= config.threshold);
+    }
+  }
+  // Cameras that ran to the deadline decided at it; cancelled ones didn't
+  for (auto &cf : step) {
+    if (!cancelled && cf.decide_ms == 0.0)
+      cf.decide_ms = elapsed();
   }
+}
 
-  if (config.policy == AuthPolicy::STRICT_ALL)
-    return failures == 0;
-  if (config.policy == AuthPolicy::LENIENT_ANY)
-    return successes > 0;
+bool AuthEngine::policyDecided(const std::vector<CameraFrame> &step) const {
+  for (const auto &cf : step) {
+    // Lenient: the first match. Strict/adaptive: the first camera that
+    // can no longer match (rejected, or out of frames below threshold).
+    if (config.policy == AuthPolicy::LENIENT_ANY) {
+      if (cf.matched)
+        return true;
+    } else if (cf.rejected || (cf.exhausted && !cf.matched &&
+                               cf.best_score < config.threshold)) {
+      return true;
+    }
+  }
+  return false;
+}
 
-  return failures == 0;
+bool AuthEngine::verifyUser(const std::string &username) {
+  return runVerification(username).success;
 }
 
 AuthResult AuthEngine::verifyUserWithDetails(const std::string &username) {
-  AuthResult result;
-  result.success = false;
-  result.best_score = 0.0f;
+  return runVerification(username);
+}
 
-  if (!ensureModelsLoaded()) {
-    result.reason = "Failed to load models";
-    return result;
-  }
+AuthResult AuthEngine::runVerification(const std::string &username) {
+  AuthResult result;
+  // Cheap rejections first: an unknown user must not wake the models or
+  // the cameras
   if (!isValidUsername(username)) {
+    Logger::log(LogLevel::WARN,
+                "Security Warn: Invalid username string: " + username);
     result.reason = "Invalid username";
     return result;
   }
@@ -654,21 +1979,58 @@ AuthResult AuthEngine::verifyUserWithDetails(const std::string &username) {
     return result;
   }
 
-  std::ifstream f(user_file);
-  json j;
-  f >> j;
+  Logger::log(LogLevel::INFO, "Verifying user " + username + " with policy " +
+                                  std::to_string((int)config.policy));
+
+  // Model reload, user file parsing and camera start-up (open, warm-up,
+  // emitter sync) run concurrently and are joined before the first
+  // detection. On an early return the futures join before `streams` closes
+  // the cameras.
+  StreamGuard streams;
+  for (auto &ac : active_cameras)
+    streams.cams.push_back(ac.cam.get());
+  // The camera expected to decide the policy outcome soonest comes first in
+  // every step. All of them open at once, so this sets the processing and
+  // log order, not the time to a decision.
+  std::vector<std::string> ids;
+  for (const auto &ac : active_cameras)
+    ids.push_back(ac.config.id);
+  std::vector<size_t> order(ids.size());
+  std::iota(order.begin(), order.end(), 0);
+  if (config.learned_camera_order)
+    order = camera_history_.order(ids,
+                                  config.policy == AuthPolicy::LENIENT_ANY);
+  std::vector<std::future<cv::Mat>> first_frames(active_cameras.size());
+  for (size_t i : order) {
+    Camera *cam = active_cameras[i].cam.get();
+    first_frames[i] = std::async(std::launch::async, [this, cam] {
+      auto tuning = captureTuning();
+      return cam->openStream() ? cam->readFrame() : cv::Mat();
+    });
+  }
+  auto models_ready = std::async(std::launch::async,
+                                 [this] { return ensureModelsLoaded(); });
+  auto user_json = std::async(std::launch::async, [&user_file] {
+    std::ifstream f(user_file);
+    json j;
+    f >> j;
+    return j;
+  });
 
   int participants = 0;
   int successes = 0;
   int failures = 0;
   bool any_no_face = false;
-  float overall_best_score = 0.0f;
-
-  for (auto &ac : active_cameras) {
-    std::string id = ac.config.id;
-    cv::Mat frame = captureFrame(ac.cam.get());
-
+  std::string quality_issue;
+
+  // Participation Check
+  std::vector<std::pair<ActiveCamera *, cv::Mat>> captured;
+  for (size_t i : order) {
+    auto &ac = active_cameras[i];
+    const std::string &id = ac.config.id;
+    cv::Mat frame = first_frames[i].get();
     if (frame.empty()) {
+      Logger::log(LogLevel::WARN, "Camera " + id + " failed to capture.");
       if (config.policy == AuthPolicy::STRICT_ALL ||
           (config.policy == AuthPolicy::ADAPTIVE && ac.config.mandatory)) {
         result.reason = "Camera " + id + " failed to capture";
@@ -676,94 +2038,169 @@ AuthResult AuthEngine::verifyUserWithDetails(const std::string &username) {
       }
       continue;
     }
+    captured.emplace_back(&ac, frame);
+  }
 
-    participants++;
+  if (!models_ready.get()) {
+    Logger::log(LogLevel::ERROR, "CRITICAL: Failed to load models!");
+    result.reason = "Failed to load models";
+    return result;
+  }
+  json j = user_json.get();
 
-    // Load embeddings
-    std::string emb_array_key = "embeddings_" + ac.config.type;
-    std::string emb_key = "embedding_" + ac.config.type;
-    std::vector<std::vector<float>> all_embeddings;
+  std::vector<CameraFrame> step;
+  for (auto &[acp, frame] : captured) {
+    auto &ac = *acp;
+    const std::string &id = ac.config.id;
 
-    if (j.contains(emb_array_key) && j[emb_array_key].is_array()) {
-      for (const auto &entry : j[emb_array_key]) {
-        if (entry.contains("data")) {
-          all_embeddings.push_back(entry["data"].get<std::vector<float>>());
+    // Single upload (the pipeline is known once the models are loaded);
+    // the brightness check already reads the device copy
+    CameraFrame cf;
+    cf.ac = &ac;
+    cf.setFrame(frame, use_umat_);
+
+    if (ac.config.min_brightness > 0) {
+      double b = calculateBrightness(cf.image());
+      if (b < ac.config.min_brightness) {
+        if (config.policy == AuthPolicy::ADAPTIVE && ac.config.mandatory) {
+          Logger::log(LogLevel::WARN,
+                      "Mandatory Camera " + id + " is too dark (" +
+                          std::to_string(b) + " < " +
+                          std::to_string(ac.config.min_brightness) +
+                          "). Failing.");
+          result.reason = "Camera " + id + " too dark";
+          return result;
         }
+        Logger::log(LogLevel::DEBUG,
+                    "Camera " + id + " too dark (" + std::to_string(b) + " < " +
+                        std::to_string(ac.config.min_brightness) +
+                        "). Skipping.");
+        continue;
       }
-    } else if (j.contains(emb_key)) {
-      all_embeddings.push_back(j[emb_key].get<std::vector<float>>());
     }
 
-    if (all_embeddings.empty()) {
+    participants++;
+
+    cf.embeddings = loadEmbeddings(j, ac.config.type,
+                                   models.recognition.embedding_dim);
+    if (fast_recognizer)
+      cf.fast_embeddings = loadVariantEmbeddings(
+          j, ac.config.type, models.recognition_fast.version(),
+          models.recognition_fast.embedding_dim);
+    cf.tracker = FaceTracker(config.track_min_confidence);
+
+    if (cf.embeddings.empty()) {
+      Logger::log(LogLevel::WARN, "No embeddings found for " + ac.config.type);
       failures++;
+      if (config.save_fail)
+        cv::imwrite(config.log_dir + "fail_missing_" + id + "_" + username +
+                        ".jpg",
+                    frame);
       continue;
     }
 
-    // Detect faces
-    cv::Mat faces;
-    detector->setInputSize(frame.size());
-    detector->detect(frame, faces);
+    step.push_back(std::move(cf));
+  }
 
-    bool match = false;
-    if (faces.rows >= 1) {
-      cv::Mat aligned_face, curr_emb;
-      float best_score = 0.0f;
-
-      for (int i = 0; i < faces.rows; i++) {
-        recognizer->alignCrop(frame, faces.row(i), aligned_face);
-        recognizer->feature(aligned_face, curr_emb);
-
-        for (const auto &stored_vec : all_embeddings) {
-          cv::Mat stored_emb(1, stored_vec.size(), CV_32F,
-                             const_cast<float *>(stored_vec.data()));
-          float score = cosine_similarity(curr_emb, stored_emb);
-          if (score > best_score)
-            best_score = score;
-        }
-      }
+  // A camera without embeddings already fails strict and adaptive
+  if (config.policy != AuthPolicy::LENIENT_ANY && failures > 0) {
+    Logger::log(LogLevel::DEBUG,
+                "Policy outcome decided before detection, skipping it.");
+    step.clear();
+  }
 
-      if (best_score > overall_best_score)
-        overall_best_score = best_score;
+  verifyFrames(step);
 
-      if (best_score >= config.threshold) {
+  if (config.learned_camera_order) {
+    bool recorded = false;
+    for (const auto &cf : step) {
+      if (cf.decide_ms <= 0.0)
+        continue; // Cancelled by the policy outcome, decided nothing
+      camera_history_.at(cf.ac->config.id).record(cf.matched, cf.decide_ms);
+      recorded = true;
+    }
+    if (recorded && !camera_history_.save(config.camera_history_path))
+      Logger::log(LogLevel::DEBUG,
+                  "Cannot write " + config.camera_history_path);
+  }
+
+  for (const auto &cf : step) {
+    const std::string &id = cf.ac->config.id;
+    if (!cf.quality_issue.empty())
+      quality_issue = cf.quality_issue;
+    bool match = false;
+    if (cf.any_face) {
+      result.best_score = std::max(result.best_score, cf.best_score);
+      Logger::log(LogLevel::INFO,
+                  id + " Score: " + std::to_string(cf.best_score) +
+                      " (threshold: " + std::to_string(config.threshold) +
+                      ", embeddings: " + std::to_string(cf.embeddings.size()) +
+                      ", frames: " + std::to_string(cf.frames_seen) +
+                      ", low quality: " +
+                      std::to_string(cf.low_quality_frames) +
+                      (cf.fast_embeddings.empty()
+                           ? std::string()
+                           : ", fast stage: " +
+                                 std::to_string(cf.fast_decisions) +
+                                 (cf.fast_matched ? " match at " : " best ") +
+                                 std::to_string(cf.fast_score)) +
+                      (config.score_fusion
+                           ? ", evidence: " +
+                                 std::to_string(cf.evidence.evidence())
+                           : std::string()) +
+                      ")");
+      if (cf.matched) {
         match = true;
-        successes++;
+        Logger::log(LogLevel::INFO, id + " MATCH.");
+        if (!cf.best_face.empty())
+          cf.ac->last_face_px = std::min(cf.best_face.at<float>(0, 2),
+                                         cf.best_face.at<float>(0, 3));
       } else {
-        failures++;
+        Logger::log(LogLevel::INFO,
+                    id + (cf.rejected
+                              ? " MISMATCH: evidence reached reject bound."
+                              : " MISMATCH: score below threshold."));
       }
     } else {
       any_no_face = true;
+      Logger::log(LogLevel::WARN, id + " NO_FACE_DETECTED in frame.");
+    }
+
+    if (match) {
+      successes++;
+      if (config.save_success)
+        cv::imwrite(config.log_dir + "success_" + id + "_" + username + ".jpg",
+                    cf.frame);
+    } else {
       failures++;
+      if (config.save_fail)
+        cv::imwrite(config.log_dir + "fail_" + id + "_" + username + ".jpg",
+                    cf.frame);
     }
   }
 
-  result.best_score = overall_best_score;
-
   if (participants == 0) {
+    Logger::log(LogLevel::WARN, "No cameras verified (all failed or skipped).");
     result.reason = "No cameras participated";
     return result;
   }
 
-  bool auth_ok = false;
-  if (config.policy == AuthPolicy::STRICT_ALL)
-    auth_ok = (failures == 0);
-  else if (config.policy == AuthPolicy::LENIENT_ANY)
-    auth_ok = (successes > 0);
+  if (config.policy == AuthPolicy::LENIENT_ANY)
+    result.success = (successes > 0);
   else
-    auth_ok = (failures == 0);
-
-  if (auth_ok) {
-    result.success = true;
+    result.success = (failures == 0);
+  if (result.success)
     return result;
-  }
 
   // Determine failure reason
   if (any_no_face) {
     result.reason = "No face detected";
-  } else if (overall_best_score > 0) {
+  } else if (result.best_score <= 0 && !quality_issue.empty()) {
+    result.reason = "Poor image quality (" + quality_issue + ")";
+  } else if (result.best_score > 0) {
     std::ostringstream oss;
     oss << std::fixed << std::setprecision(2);
-    oss << "Face mismatch (score: " << overall_best_score << ")";
+    oss << "Face mismatch (score: " << result.best_score << ")";
     result.reason = oss.str();
   } else {
     result.reason = "Authentication failed";
@@ -771,10 +2208,28 @@ AuthResult AuthEngine::verifyUserWithDetails(const std::string &username) {
   return result;
 }
 
+bool AuthEngine::embedSingleFace(const ActiveCamera &ac, const cv::Mat &frame,
+                                 cv::Mat &faces, std::vector<float> &vec,
+                                 std::vector<float> &fast_vec) {
+  cv::UMat uframe;
+  if (use_umat_)
+    frame.copyTo(uframe);
+  detectFaces(ac, frameInput(frame, uframe), faces);
+  if (faces.rows != 1)
+    return false;
+  cv::Mat aligned;
+  alignFace(*recognizer, frameInput(frame, uframe), faces.row(0), aligned);
+  embed(aligned, vec);
+  if (!fastFeature(aligned, fast_vec))
+    fast_vec.clear();
+  return true;
+}
+
 std::pair<bool, std::string>
 AuthEngine::enrollUser(const std::string &username) {
   if (!ensureModelsLoaded())
     return {false, "Failed to load AI models."};
+  waitForWarmup();
   if (!isValidUsername(username)) {
     std::cerr << "[AuthEngine] Security Warn: Invalid username string: "
               << username << std::endl;
@@ -827,11 +2282,9 @@ AuthEngine::enrollUser(const std::string &username) {
       return {false, "Camera " + id + " failed (empty frame)."};
     }
 
-    detector->setInputSize(frame.size());
     cv::Mat faces;
-    detector->detect(frame, faces);
-
-    if (faces.rows != 1) {
+    std::vector<float> vec, fast_vec;
+    if (!embedSingleFace(ac, frame, faces, vec, fast_vec)) {
       std::string err = "Found " + std::to_string(faces.rows) + " faces in " +
                         id + ". Expecting exactly 1.";
       Logger::log(LogLevel::WARN, "Enroll failed: " + err);
@@ -843,16 +2296,16 @@ AuthEngine::enrollUser(const std::string &username) {
       return {false, err};
     }
 
-    cv::Mat aligned, emb;
-    recognizer->alignCrop(frame, faces.row(0), aligned);
-    recognizer->feature(aligned, emb);
-
-    std::vector<float> vec;
-    emb.reshape(1, 1).copyTo(vec);
-
     // Store as pending embedding (will be finalized by setLabel)
     std::string pending_key = "_pending_" + ac.config.type;
     j[pending_key] = vec;
+
+    // Same crop through the cascade's fast stage, so both are enrolled
+    if (!fast_vec.empty())
+      j[pending_key + "_variants"] = {
+          {models.recognition_fast.version(), fast_vec}};
+    else
+      j.erase(pending_key + "_variants");
   }
 
   Logger::log(LogLevel::INFO, "Saving pending enrollment...");
@@ -886,6 +2339,15 @@ bool AuthEngine::setLabel(const std::string &username,
 
     if (j.contains(pending_key)) {
       auto embedding_data = j[pending_key];
+      // Fast-stage embeddings of the same capture; stale ones must not
+      // survive a replaced entry
+      std::string variants_key = pending_key + "_variants";
+      auto store_variants = [&j, &variants_key](json &entry) {
+        if (j.contains(variants_key))
+          entry["variants"] = j[variants_key];
+        else
+          entry.erase("variants");
+      };
 
       // Initialize array if not exists
       if (!j.contains(emb_array_key)) {
@@ -913,7 +2375,8 @@ bool AuthEngine::setLabel(const std::string &username,
           if (entry["label"] == label) {
             entry["data"] = embedding_data;
             entry["created"] = std::time(nullptr);
-            entry["model_version"] = getModelVersion(recognition_model_path);
+            entry["model_version"] = models.recognition.version();
+            store_variants(entry);
             found = true;
             break;
           }
@@ -932,7 +2395,8 @@ bool AuthEngine::setLabel(const std::string &username,
           if (entry["label"] == label) {
             entry["data"] = embedding_data;
             entry["created"] = std::time(nullptr);
-            entry["model_version"] = getModelVersion(recognition_model_path);
+            entry["model_version"] = models.recognition.version();
+            store_variants(entry);
             found = true;
             break;
           }
@@ -942,12 +2406,14 @@ bool AuthEngine::setLabel(const std::string &username,
           new_entry["label"] = label;
           new_entry["data"] = embedding_data;
           new_entry["created"] = std::time(nullptr);
-          new_entry["model_version"] = getModelVersion(recognition_model_path);
+          new_entry["model_version"] = models.recognition.version();
+          store_variants(new_entry);
           j[emb_array_key].push_back(new_entry);
         }
       }
 
       j.erase(pending_key);
+      j.erase(variants_key);
       updated = true;
     }
   }
@@ -966,6 +2432,7 @@ bool AuthEngine::trainUser(const std::string &username,
                            const std::string &label, bool create_new) {
   if (!ensureModelsLoaded())
     return false;
+  waitForWarmup();
   if (!isValidUsername(username)) {
     Logger::log(LogLevel::WARN,
                 "Security Warn: Invalid username string: " + username);
@@ -995,20 +2462,19 @@ bool AuthEngine::trainUser(const std::string &username,
     }
 
     cv::Mat faces;
-    detector->setInputSize(frame.size());
-    detector->detect(frame, faces);
-    if (faces.rows != 1) {
+    std::vector<float> new_vec, fast_vec;
+    if (!embedSingleFace(ac, frame, faces, new_vec, fast_vec)) {
       Logger::log(LogLevel::WARN, "Train: Expected 1 face, found " +
                                       std::to_string(faces.rows));
       continue;
     }
+    cv::Mat new_emb(1, new_vec.size(), CV_32F, new_vec.data());
+    const std::string model_version = models.recognition.version();
 
-    cv::Mat aligned, new_emb;
-    recognizer->alignCrop(frame, faces.row(0), aligned);
-    recognizer->feature(aligned, new_emb);
-
-    std::vector<float> new_vec;
-    new_emb.reshape(1, 1).copyTo(new_vec);
+    // Cascade fast stage: keep its embedding in step with the full one
+    const bool has_fast = !fast_vec.empty();
+    const std::string fast_version =
+        has_fast ? models.recognition_fast.version() : "";
 
     // Initialize array if needed
     if (!j.contains(emb_array_key)) {
@@ -1038,6 +2504,9 @@ bool AuthEngine::trainUser(const std::string &username,
                            : label;
       entry["data"] = new_vec;
       entry["created"] = std::time(nullptr);
+      entry["model_version"] = model_version;
+      if (has_fast)
+        entry["variants"][fast_version] = fast_vec;
       j[emb_array_key].push_back(entry);
       Logger::log(LogLevel::INFO, "Train: Added new embedding '" +
                                       entry["label"].get<std::string>() + "'");
@@ -1048,13 +2517,30 @@ bool AuthEngine::trainUser(const std::string &username,
       for (auto &entry : j[emb_array_key]) {
         if (entry["label"] == label) {
           std::vector<float> old_vec = entry["data"].get<std::vector<float>>();
-          cv::Mat old_emb(1, old_vec.size(), CV_32F, old_vec.data());
-          cv::Mat avg = old_emb + new_emb;
-          cv::normalize(avg, avg);
-          std::vector<float> avg_vec;
-          avg.reshape(1, 1).copyTo(avg_vec);
+          std::vector<float> avg_vec = new_vec;
+          // Enrolled with a model of another embedding size: replace
+          if (old_vec.size() == new_vec.size()) {
+            cv::Mat old_emb(1, old_vec.size(), CV_32F, old_vec.data());
+            cv::Mat avg = old_emb + new_emb;
+            cv::normalize(avg, avg);
+            avg.reshape(1, 1).copyTo(avg_vec);
+          }
           entry["data"] = avg_vec;
           entry["created"] = std::time(nullptr);
+          entry["model_version"] = model_version;
+          if (has_fast) {
+            auto &variant = entry["variants"][fast_version];
+            if (variant.is_array() && variant.size() == fast_vec.size()) {
+              std::vector<float> old_fast = variant.get<std::vector<float>>();
+              cv::Mat fast_avg = cv::Mat(1, old_fast.size(), CV_32F,
+                                         old_fast.data()) +
+                                 cv::Mat(1, fast_vec.size(), CV_32F,
+                                         fast_vec.data());
+              cv::normalize(fast_avg, fast_avg);
+              fast_avg.reshape(1, 1).copyTo(fast_vec);
+            }
+            variant = fast_vec;
+          }
           found = true;
           Logger::log(LogLevel::INFO,
                       "Train: Refined embedding '" + label + "'");
@@ -1068,6 +2554,9 @@ bool AuthEngine::trainUser(const std::string &username,
         entry["label"] = label;
         entry["data"] = new_vec;
         entry["created"] = std::time(nullptr);
+        entry["model_version"] = model_version;
+        if (has_fast)
+          entry["variants"][fast_version] = fast_vec;
         j[emb_array_key].push_back(entry);
         Logger::log(LogLevel::INFO,
                     "Train: Created new embedding '" + label + "'");
@@ -1168,6 +2657,7 @@ bool AuthEngine::removeEmbedding(const std::string &username,
 bool AuthEngine::testCameraAndAuth() {
   if (!ensureModelsLoaded())
     return false;
+  waitForWarmup();
   bool any_ok = false;
   Logger::log(LogLevel::INFO,
               "Testing " + std::to_string(active_cameras.size()) + " cameras.");
@@ -1177,9 +2667,8 @@ bool AuthEngine::testCameraAndAuth() {
     Logger::log(LogLevel::INFO, "Testing Camera " + id + "...");
     cv::Mat frame = captureFrame(ac.cam.get());
     if (!frame.empty()) {
-      detector->setInputSize(frame.size());
       cv::Mat faces;
-      detector->detect(frame, faces);
+      detectFaces(ac, frame, faces);
       Logger::log(LogLevel::INFO, "  -> Capture OK. Faces detected: " +
                                       std::to_string(faces.rows));
       any_ok = true;
@@ -1,9 +1,28 @@
 #pragma once
 
+#include "backend_probe.hpp"
 #include "camera.hpp"
+#include "camera_history.hpp"
 #include "constants.hpp"
+#include "cpu_affinity.hpp"
+#include "face_detector.hpp"
+#include "face_quality.hpp"
+#include "face_tracker.hpp"
+#include "image_ops.hpp"
+#include "inference_watchdog.hpp"
+#include "memory_lock.hpp"
+#include "memory_pressure.hpp"
+#include "memory_usage.hpp"
+#include "model_registry.hpp"
+#include "parallel_backend.hpp"
+#include "score_fusion.hpp"
 
+#include <atomic>
 #include <chrono>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
 #include <opencv2/dnn.hpp>
 #include <opencv2/opencv.hpp>
 #include <string>
@@ -44,6 +63,10 @@ public:
                                bool create_new = false);
   [[nodiscard]] bool testCameraAndAuth();
   [[nodiscard]] bool performMaintenance();
+  // One-line diagnostics: active backend, CPU fallback state, stage latency
+  [[nodiscard]] std::string statusReport() const;
+  // Per-component memory use and process RSS (MEMORY command)
+  [[nodiscard]] std::string memoryReport() const;
 
   // Multi-embedding management
   [[nodiscard]] std::vector<std::string>
@@ -69,19 +92,28 @@ private:
     std::string enroll_hdr = ""; // "", "auto", "on", "off" - empty = use global
     std::string enroll_averaging = ""; // "", "on", "off" - empty = use global
     int enroll_average_frames = 0;     // 0 = use global
+
+    // Detection resolution (recognition always uses the full frame)
+    int detect_width = 0;         // 0 = capture resolution
+    int detect_height = 0;        // 0 = capture resolution
+    int detect_max_side = 0;      // 0 = no limit
+    bool detect_adaptive = false; // Shrink based on last matched face size
   };
 
   // Helper struct to hold a running camera and its config
   struct ActiveCamera {
     std::unique_ptr<Camera> cam;
     CameraDefinition config;
+    float last_face_px = 0.0f; // Shorter box side of the last matched face
   };
 
   struct Config {
     float threshold = 0.363f;
     float detection_threshold = 0.9f;
     int timeout_ms = 3000;
-    int max_embeddings = 5; // 0 = unlimited
+    int max_embeddings = 5;      // 0 = unlimited
+    int max_faces = 3;           // Faces recognized per frame, 0 = unlimited
+    float min_face_size = 40.0f; // Shorter box side (px) to be a candidate
 
     AuthPolicy policy = AuthPolicy::ADAPTIVE;
     std::vector<CameraDefinition> camera_defs;
@@ -91,6 +123,60 @@ private:
     std::string log_dir = "/var/log/linuxcampam/";
     std::vector<std::string> provider_priority;
     int model_keep_alive_sec = 0; // 0 = Always loaded
+    bool unload_keep_buffers = true; // Keep ONNX bytes after keep-alive unload
+    int memory_budget_mb = 0; // RSS above which idle models unload, 0 = off
+    bool trim_heap = true;    // malloc_trim after unloading
+    std::string inference_cpus; // "auto", a CPU list, or empty (no pinning)
+    std::string capture_cpus;
+    SchedMode capture_priority = SchedMode::NORMAL;
+    bool thread_pool = true;  // Own pool as OpenCV's parallel backend
+    int thread_pool_size = 0; // Workers, 0 = CPUs in the affinity mask - 1
+    int detect_threads = 0;    // cv::setNumThreads per stage, 0 = default
+    int recognize_threads = 0;
+    bool pipeline = true;   // Overlap capture, detection and recognition
+    int pipeline_depth = 2; // Frames each camera may read ahead
+    bool learned_camera_order = true; // Order cameras by their history
+    std::string camera_history_path = linuxcampam::CAMERA_HISTORY_PATH;
+    bool lock_memory = false; // mlock model memory after loading
+    int lock_memory_max_mb = 256;
+    bool pressure_eviction = false;  // PSI-driven instead of keep-alive timer
+    std::string psi_path = "/proc/pressure/memory";
+    double pressure_some_avg10 = 10.0; // % stalled: drop recognizers
+    double pressure_full_avg10 = 5.0;  // % fully stalled: drop detector too
+    int recognition_batch_size = 8; // Max crops per SFace pass, 1 = no batch
+    bool warmup = true; // Synthetic inference in the background after load
+    std::string opencl_cache_dir =
+        std::string(linuxcampam::CACHE_DIR) + "/opencl";
+    std::string probe_cache_path = linuxcampam::PROBE_CACHE_PATH;
+    double inference_budget_ms = 500.0; // Per detect/recognize stage, 0 = off
+    int watchdog_strikes = 3;       // Overruns in a row before CPU fallback
+    int watchdog_reprobe_sec = 300; // Retry the accelerated backend after
+    bool batch_detection = true;    // One YuNet pass for all cameras
+    cv::Size batch_detect_size = cv::Size(640, 480);
+    int detector_cache_size = 4; // YuNet instances kept per input size
+    int detect_min_face_px = 64; // Smallest face allowed by adaptive scaling
+    bool two_stage_detection = false; // Coarse full-frame pass, fine ROI pass
+    cv::Size coarse_detect_size = cv::Size(160, 120);
+    cv::Size fine_detect_size = cv::Size(320, 320);
+    bool tracking = true;           // Track faces between frames
+    int track_redetect_frames = 5;  // Full detection at least every N frames
+    float track_min_confidence = 0.6f;
+    float track_realign_ratio = 0.05f; // Landmark shift that forces re-embed
+
+    // Pre-recognition quality gate
+    bool quality_gate = true;
+    QualityLimits quality;
+
+    // Sequential score fusion (SPRT) instead of a single-frame threshold
+    bool score_fusion = false;
+    ScoreModel score_model;
+    double fusion_false_accept = 1e-4;
+    double fusion_false_reject = 1e-3;
+
+    // Recognizer cascade: fast model decides unless its score is within
+    // cascade_margin of cascade_threshold
+    float cascade_threshold = 0.4f;
+    float cascade_margin = 0.08f;
 
     // Capture settings
     std::string enroll_hdr = "auto"; // auto | on | off
@@ -98,6 +184,7 @@ private:
     int enroll_average_frames = 5;
     bool verify_averaging = false;
     int verify_average_frames = 3;
+    bool ir_frame_sync = true; // Skip unlit frames of strobing IR emitters
 
     // Paths
     std::string users_dir = linuxcampam::USERS_DIR;
@@ -105,16 +192,169 @@ private:
     std::string ir_emitter_path = linuxcampam::IR_EMITTER_PATH;
   } config;
 
-  cv::Ptr<cv::FaceDetectorYN> detector;
+  // YuNet instances per input size (no reshape when switching cameras)
+  std::unique_ptr<DetectorCache> detector;
   cv::Ptr<cv::FaceRecognizerSF> recognizer;
+  // Raw SFace network for batched feature extraction (NCHW input)
+  cv::dnn::Net recognizer_net;
+  bool batch_recognition_ok_ = true;
+  // Cross-camera YuNet batch (only created with more than one camera)
+  std::unique_ptr<BatchFaceDetector> batch_detector;
+  bool batch_detection_ok_ = true;
+  // Optional first stage of the recognizer cascade. Must take the same
+  // 112x112 aligned crop as SFace (e.g. an int8 SFace); has its own
+  // embeddings, stored per entry under "variants".
+  cv::Ptr<cv::FaceRecognizerSF> fast_recognizer;
+  cv::dnn::Net fast_recognizer_net;
+  bool fast_batch_ok_ = true;
 
-  std::string detection_model_path;
-  std::string recognition_model_path;
+  // Model files, precision, input and embedding sizes ([Models])
+  ModelRegistry models;
 
   std::vector<ActiveCamera> active_cameras;
 
+  // Per-camera state of a verification: the current frame plus what the
+  // earlier frames of the same request established
+  struct CameraFrame {
+    ActiveCamera *ac = nullptr;
+    cv::Mat frame;
+    cv::UMat uframe; // Device copy of frame (OpenCL pipeline only)
+    std::vector<std::vector<float>> embeddings;
+    std::vector<std::vector<float>> fast_embeddings; // Empty = no cascade
+    cv::Mat faces;
+    float frame_score = 0.0f; // Best score on the current frame
+    float best_score = 0.0f;  // Best score over all frames
+    cv::Mat best_face;        // Face row that produced best_score
+    bool any_face = false;
+    bool matched = false;
+    bool exhausted = false; // Camera stopped delivering frames
+    int frames_seen = 0;
+    int low_quality_frames = 0; // Frames where every face failed the gate
+    std::string quality_issue;  // Last reason a face was gated
+    bool scored = false; // frame_score was recomputed for the current frame
+    SequentialTest evidence; // Per-camera SPRT over recognized frames
+    bool rejected = false;   // Evidence crossed the reject bound
+    int fast_decisions = 0;  // Faces settled by the cascade's fast stage
+    // Fast stage accepted a face. Its scores are on the fast model's own
+    // cosine scale, so they stay out of best_score and fusion.
+    bool fast_matched = false;
+    float fast_score = 0.0f; // Best raw fast-stage score over all frames
+    double decide_ms = 0.0;  // First frame to own decision, 0 = cancelled
+
+    // Temporal tracking
+    FaceTracker tracker; // Follows faces.row(0), the top-ranked face
+    bool tracked = false; // `faces` came from the tracker, not YuNet
+    int frames_since_detect = 0;
+    cv::Mat scored_face; // Face row last sent through recognition
+
+    // One upload per frame on the OpenCL pipeline. Fresh buffers rather
+    // than copies into the old ones: a snapshot still being recognized
+    // may share them (see takeScores).
+    void setFrame(const cv::Mat &f, bool upload) {
+      frame = f;
+      faces.release();
+      uframe.release();
+      if (upload)
+        f.copyTo(uframe);
+    }
+    cv::_InputArray image() const { return frameInput(frame, uframe); }
+
+    // Recognition state back from a snapshot of this camera that was
+    // scored while the camera itself moved on to its next frame
+    void takeScores(CameraFrame &from) {
+      embeddings = std::move(from.embeddings);
+      fast_embeddings = std::move(from.fast_embeddings);
+      frame_score = from.frame_score;
+      best_score = from.best_score;
+      best_face = from.best_face;
+      scored_face = from.scored_face;
+      scored = from.scored;
+      quality_issue = from.quality_issue;
+      low_quality_frames = from.low_quality_frames;
+      fast_decisions = from.fast_decisions;
+      fast_matched = from.fast_matched;
+      fast_score = from.fast_score;
+    }
+  };
+
+  // Scale (<= 1) at which YuNet runs for this camera's frames
+  float detectionScale(const ActiveCamera &ac, cv::Size frame_size) const;
+  // Detect on a downscaled copy; faces are returned in full-frame coordinates
+  // (resized on the device for a cv::UMat frame)
+  void detectFaces(const ActiveCamera &ac, cv::InputArray frame,
+                   cv::Mat &faces);
+  // Drop faces below min_face_size and order the rest by box area times
+  // detection score, keeping at most max_faces
+  void rankFaces(cv::Mat &faces) const;
+  // Detect faces on all frames of the step, batched across cameras
+  void detectFrames(std::vector<CameraFrame *> &frames);
+  // Drop faces failing the quality gate; returns false if none are left
+  bool gateFaces(CameraFrame &cf);
+  // Recognize ranked faces across all frames of the step in batches, one
+  // rank per round, stopping per camera at the first face over threshold
+  void scoreFrames(std::vector<CameraFrame *> &frames);
+  // Run a recognizer over aligned 112x112 crops (resized to its input
+  // size), batched through `net` where the network allows (batch_ok is
+  // cleared once it doesn't)
+  void extractFeatures(cv::FaceRecognizerSF &sf, cv::dnn::Net &net,
+                       bool &batch_ok, cv::Size input_size,
+                       const std::vector<cv::Mat> &aligned,
+                       std::vector<cv::Mat> &features);
+  // Embedding of an aligned crop from the full recognizer
+  bool embed(const cv::Mat &aligned, std::vector<float> &vec);
+  // Embedding of an aligned crop from the cascade's fast stage, if loaded
+  bool fastFeature(const cv::Mat &aligned, std::vector<float> &vec);
+  // Verify (or learn) a recognizer's embedding size after loading it
+  bool checkEmbeddingSize(ModelSpec &spec, cv::FaceRecognizerSF &sf,
+                          cv::dnn::Net &net, bool &batch_ok);
+  // Load the fast stage on the given backend (no-op without a model path)
+  void loadFastRecognizer(int backend_id, int target_id);
+  // Networks as loadModels() builds them, from buffers_ when filled; int8
+  // models stay on the CPU whatever backend is asked for
+  std::unique_ptr<DetectorCache> makeDetector(int backend_id,
+                                              int target_id) const;
+  std::unique_ptr<BatchFaceDetector> makeBatchDetector(int backend_id,
+                                                       int target_id) const;
+  // False if the model's embedding size doesn't match the config
+  bool makeRecognizer(int backend_id, int target_id,
+                      cv::Ptr<cv::FaceRecognizerSF> &sf, cv::dnn::Net &net,
+                      bool &batch_ok);
+  // Follow the top face of every frame by tracking where possible; returns
+  // the frames that need a full detection
+  std::vector<CameraFrame *> trackFrames(std::vector<CameraFrame *> &frames);
+  // Rank detected faces and (re)start the trackers
+  void finishDetection(std::vector<CameraFrame *> &detected);
+  // Multi-frame loop: read, track/detect and recognize on every camera until
+  // each one matched, stopped delivering frames or timeout_ms expired. With
+  // `pipeline` on, cameras read ahead on their own threads and recognition
+  // of one step overlaps tracking and detection of the next.
+  void verifyFrames(std::vector<CameraFrame> &step);
+  // verifyUser/verifyUserWithDetails: open cameras, verifyFrames, policy
+  AuthResult runVerification(const std::string &username);
+  // The policy outcome no longer depends on the cameras still running
+  bool policyDecided(const std::vector<CameraFrame> &step) const;
+  // Success rate and time to decision per camera, persisted to
+  // camera_history_path; decides which camera starts first
+  CameraHistory camera_history_;
+  // Detect exactly one face and embed it with the full and (if loaded) the
+  // fast recognizer. Enrollment and training; `faces` is left for the
+  // caller's error message.
+  bool embedSingleFace(const ActiveCamera &ac, const cv::Mat &frame,
+                       cv::Mat &faces, std::vector<float> &vec,
+                       std::vector<float> &fast_vec);
+
   // Internal helper to capture from a specific camera instance
   cv::Mat captureFrame(Camera *cam);
+  // Next frame of an open stream, read under captureTuning()
+  cv::Mat readCameraFrame(Camera *cam);
+  // Capture-stage CPU set and priority for the calling thread until the
+  // returned object is destroyed; null when not configured
+  std::unique_ptr<ThreadTuning> captureTuning();
+  std::vector<int> capture_cpus_;
+  // Shared by every OpenCV parallel region. Verification stages submit at
+  // HIGH priority, warm-up and re-probing at LOW.
+  std::shared_ptr<ThreadPool> pool_;
+  std::atomic<bool> capture_tuning_warned_{false};
 
   // Helper to match a face in a frame against a stored embedding
   // Returns score (0.0 - 1.0)
@@ -122,8 +362,50 @@ private:
                   cv::Mat &out_face);
 
   // Helper to calculate brightness
-  double calculateBrightness(const cv::Mat &frame);
-  void fallbackToCPU();
+  double calculateBrightness(cv::InputArray frame);
+
+  // Frames are uploaded to a cv::UMat and preprocessed on the device when
+  // the active backend targets OpenCL (see image_ops.hpp)
+  bool use_umat_ = false;
+  void updateFramePipeline();
+
+  // Backend watchdog. Detection and recognition of each verification step
+  // run through runWatched(); an exception, non-finite output or repeated
+  // budget overrun switches all networks to the CPU, and a failed stage is
+  // retried there. performMaintenance() re-probes the accelerated backend
+  // in the background and switches back once it is correct and faster.
+  // `threads` > 0 sets cv::setNumThreads for the duration of the stage.
+  void runWatched(InferenceWatchdog &watchdog, const std::string &stage,
+                  int threads, const std::function<void()> &run);
+  // runWatched in two halves, for stages that run concurrently: timeStage
+  // may run on any thread, settleStage (fallback, retry) only on the
+  // verifying thread once no other stage is in flight.
+  struct StageRun {
+    double ms = 0.0;
+    bool accelerated = false; // Backend at the start of the run
+    std::exception_ptr error;
+  };
+  StageRun timeStage(int threads, const std::function<void()> &run);
+  void settleStage(InferenceWatchdog &watchdog, const std::string &stage,
+                   const StageRun &result, const std::function<void()> &run);
+  bool acceleratedBackend() const {
+    return backend_.backend_id != cv::dnn::DNN_BACKEND_OPENCV ||
+           backend_.target_id != cv::dnn::DNN_TARGET_CPU;
+  }
+  void fallbackToCPU(const std::string &reason);
+  // Recreate every network on `to`; false (old networks kept) on failure
+  bool switchBackend(const BackendCandidate &to);
+  void checkFallbackRecovery();
+  BackendCandidate backend_{"CPU", cv::dnn::DNN_BACKEND_OPENCV,
+                            cv::dnn::DNN_TARGET_CPU}; // Active backend
+  InferenceWatchdog detect_watchdog_;
+  InferenceWatchdog recognize_watchdog_;
+  bool cpu_fallback_ = false;
+  BackendCandidate fallback_from_;
+  std::string fallback_reason_;
+  std::chrono::steady_clock::time_point fallback_since_;
+  std::chrono::steady_clock::time_point last_reprobe_;
+  std::future<ProbeReport> reprobe_;
 
   // Security
   [[nodiscard]] bool isValidUsername(const std::string &username);
@@ -132,6 +414,46 @@ private:
   [[nodiscard]] bool ensureModelsLoaded();
   [[nodiscard]] bool loadModels();
   void unloadModels();
+  // First available entry of provider_priority; "auto" takes the fastest
+  // backend that matched the CPU outputs in probeProviders()
+  void selectProvider(int &backend_id, int &target_id);
+  // Stored benchmark for this OpenCV build, hardware and model set, or a
+  // fresh one (written back to probe_cache_path). Null: stay on CPU.
+  const ProbeResult *probeProviders();
+  ProbeReport probe_report_;
+  bool probe_benchmarked_ = false;
+  // Persistent OpenCL program cache, so kernels are built once per driver
+  void configureOpenCLCache();
+  // Synthetic forward passes through every network right after loading, on
+  // a background thread, so the first request pays neither lazy graph
+  // initialization nor OpenCL kernel builds
+  void warmUp();
+  // Block until a running warm-up finished. Must precede any inference on
+  // the request thread (the networks are not safe for concurrent use).
+  void waitForWarmup();
+  std::future<void> warmup_;
+  std::vector<cv::Size> warm_sizes_; // Detector sizes in use before unload
+  // Model bytes held while unloaded, consumed by the next loadModels()
+  ModelBuffers buffers_;
+  double last_load_ms_ = 0.0;
+  bool last_load_from_memory_ = false;
+
+  // Staged release under memory pressure: LOW drops the recognizers,
+  // MEDIUM also the detector, CRITICAL also the buffered model bytes.
+  // True if anything was released.
+  bool evict(PressureLevel level);
+  // Hand freed model memory back to the kernel (trim_heap)
+  void reclaimHeap();
+  bool overMemoryBudget() const;
+  size_t model_rss_ = 0;  // Anonymous RSS growth of the last full load
+  // lock_memory: pin the anonymous memory grown since init (graphs, weights,
+  // warm-up blobs, buffered model bytes) so an idle period can't page it out
+  void lockMemory();
+  MemoryLocker locker_;
+  std::vector<MemoryRegion> baseline_maps_; // Anonymous mappings at init
+  size_t frame_bytes_ = 0; // Frames of the last detection step
+  std::unique_ptr<MemoryPressureMonitor> pressure_; // Null: timer eviction
+  PressureLevel pressure_level_ = PressureLevel::NONE;
 
   std::chrono::steady_clock::time_point last_activity_;
 };
@@ -0,0 +1,290 @@
+#include "backend_probe.hpp"
+
+#include "json.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <opencv2/core/cuda.hpp>
+#include <opencv2/core/ocl.hpp>
+#include <opencv2/core/version.hpp>
+#include <opencv2/dnn.hpp>
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace {
+// Relative L2 deviation accepted against the CPU outputs
+constexpr double kMaxError = 0.01;
+constexpr double kMaxErrorFP16 = 0.05;
+
+std::string lower(std::string s) {
+  std::transform(s.begin(), s.end(), s.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  return s;
+}
+
+std::string cpuModel() {
+  std::ifstream in("/proc/cpuinfo");
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.rfind("model name", 0) == 0) {
+      auto colon = line.find(':');
+      if (colon != std::string::npos)
+        return line.substr(line.find_first_not_of(" \t", colon + 1));
+    }
+  }
+  return "unknown";
+}
+
+bool isFP16(int target_id) {
+  return target_id == cv::dnn::DNN_TARGET_OPENCL_FP16 ||
+         target_id == cv::dnn::DNN_TARGET_CUDA_FP16;
+}
+
+double median(std::vector<double> v) {
+  if (v.empty())
+    return 0.0;
+  std::nth_element(v.begin(), v.begin() + v.size() / 2, v.end());
+  return v[v.size() / 2];
+}
+
+// Deterministic noise, so every candidate sees the same input
+cv::Mat syntheticImage(cv::Size size) {
+  cv::Mat img(size, CV_8UC3);
+  cv::RNG rng(0x5eed);
+  rng.fill(img, cv::RNG::UNIFORM, cv::Scalar::all(0), cv::Scalar::all(256));
+  return img;
+}
+
+// Median forward time over `iterations` after one untimed pass
+double timeForward(cv::dnn::Net &net, const cv::Mat &blob, int iterations,
+                   std::vector<cv::Mat> &outputs) {
+  const std::vector<std::string> names = net.getUnconnectedOutLayersNames();
+  net.setInput(blob);
+  net.forward(outputs, names);
+
+  std::vector<double> times;
+  for (int i = 0; i < iterations; i++) {
+    auto start = std::chrono::steady_clock::now();
+    net.setInput(blob);
+    net.forward(outputs, names);
+    times.push_back(std::chrono::duration<double, std::milli>(
+                        std::chrono::steady_clock::now() - start)
+                        .count());
+  }
+  for (auto &out : outputs)
+    out = out.clone();
+  return median(times);
+}
+
+double relativeError(const std::vector<cv::Mat> &out,
+                     const std::vector<cv::Mat> &ref) {
+  if (out.size() != ref.size())
+    return std::numeric_limits<double>::infinity();
+  double worst = 0.0;
+  for (size_t i = 0; i < out.size(); i++) {
+    if (out[i].total() != ref[i].total())
+      return std::numeric_limits<double>::infinity();
+    cv::Mat a = out[i].reshape(1, 1), b = ref[i].reshape(1, 1);
+    double scale = std::max(cv::norm(b, cv::NORM_L2), 1e-6);
+    worst = std::max(worst, cv::norm(a, b, cv::NORM_L2) / scale);
+  }
+  return worst;
+}
+} // namespace
+
+std::vector<BackendCandidate> providerCandidates(const std::string &provider) {
+  const std::string p = lower(provider);
+  if (p == "cpu")
+    return {{"CPU", cv::dnn::DNN_BACKEND_OPENCV, cv::dnn::DNN_TARGET_CPU}};
+  if (p == "opencl")
+    return {{"OpenCL", cv::dnn::DNN_BACKEND_OPENCV, cv::dnn::DNN_TARGET_OPENCL},
+            {"OpenCL-FP16", cv::dnn::DNN_BACKEND_OPENCV,
+             cv::dnn::DNN_TARGET_OPENCL_FP16}};
+  if (p == "openvino")
+    return {{"OpenVINO", cv::dnn::DNN_BACKEND_INFERENCE_ENGINE,
+             cv::dnn::DNN_TARGET_CPU}};
+  if (p == "cuda")
+    return {{"CUDA", cv::dnn::DNN_BACKEND_CUDA, cv::dnn::DNN_TARGET_CUDA},
+            {"CUDA-FP16", cv::dnn::DNN_BACKEND_CUDA,
+             cv::dnn::DNN_TARGET_CUDA_FP16}};
+  return {};
+}
+
+bool isBackendAvailable(const BackendCandidate &c) {
+  if (c.backend_id == cv::dnn::DNN_BACKEND_OPENCV &&
+      c.target_id == cv::dnn::DNN_TARGET_CPU)
+    return true;
+  if ((c.target_id == cv::dnn::DNN_TARGET_OPENCL ||
+       c.target_id == cv::dnn::DNN_TARGET_OPENCL_FP16) &&
+      !cv::ocl::haveOpenCL())
+    return false;
+  if (c.backend_id == cv::dnn::DNN_BACKEND_CUDA &&
+      cv::cuda::getCudaEnabledDeviceCount() <= 0)
+    return false;
+  for (const auto &[backend, target] : cv::dnn::getAvailableBackends()) {
+    if (backend == c.backend_id && target == c.target_id)
+      return true;
+  }
+  return false;
+}
+
+std::vector<BackendCandidate> availableBackends() {
+  std::vector<BackendCandidate> out;
+  for (const char *provider : {"cpu", "opencl", "openvino", "cuda"}) {
+    for (const auto &c : providerCandidates(provider)) {
+      if (isBackendAvailable(c))
+        out.push_back(c);
+    }
+  }
+  return out;
+}
+
+const ProbeResult *ProbeReport::best() const {
+  // Without a working CPU reference nothing was actually checked
+  if (results.empty() || !results.front().ok)
+    return nullptr;
+  const ProbeResult *best = nullptr;
+  for (const auto &r : results) {
+    if (r.ok && (!best || r.totalMs() < best->totalMs()))
+      best = &r;
+  }
+  return best;
+}
+
+std::string probeKey(const ModelSpec &detection, const ModelSpec &recognition) {
+  std::string key = std::string("opencv=") + CV_VERSION + ";cpu=" + cpuModel();
+  if (cv::ocl::haveOpenCL()) {
+    cv::ocl::Device dev = cv::ocl::Device::getDefault();
+    key += ";ocl=" + dev.name() + " " + dev.driverVersion();
+  }
+  key += ";det=" + detection.version() + ";rec=" + recognition.version();
+  return key;
+}
+
+ProbeReport probeBackends(const ModelSpec &detection,
+                          const ModelSpec &recognition,
+                          const std::vector<BackendCandidate> &candidates,
+                          int iterations) {
+  ProbeReport report;
+  report.key = probeKey(detection, recognition);
+
+  // YuNet input dims must be multiples of 32
+  cv::Size det_size((detection.input_size.width + 31) / 32 * 32,
+                    (detection.input_size.height + 31) / 32 * 32);
+  const cv::Mat det_blob = cv::dnn::blobFromImage(syntheticImage(det_size));
+  const cv::Mat rec_blob =
+      cv::dnn::blobFromImage(syntheticImage(recognition.input_size), 1.0,
+                             recognition.input_size, cv::Scalar(0, 0, 0),
+                             true, false);
+
+  std::vector<cv::Mat> det_ref, rec_ref;
+  for (const auto &c : candidates) {
+    ProbeResult r;
+    r.name = c.name;
+    r.backend_id = c.backend_id;
+    r.target_id = c.target_id;
+    if (!report.results.empty() && det_ref.empty()) {
+      // Another backend must not become its own reference
+      r.error = "no CPU reference";
+      report.results.push_back(r);
+      continue;
+    }
+
+    // Quantized models are pinned to the CPU (see ModelSpec::selectBackend)
+    int b = c.backend_id, t = c.target_id;
+    detection.selectBackend(b, t);
+    recognition.selectBackend(b, t);
+    if (b != c.backend_id || t != c.target_id) {
+      r.error = "int8 model runs on CPU only";
+      report.results.push_back(r);
+      continue;
+    }
+
+    try {
+      std::vector<cv::Mat> det_out, rec_out;
+      cv::dnn::Net det = cv::dnn::readNet(detection.path);
+      det.setPreferableBackend(c.backend_id);
+      det.setPreferableTarget(c.target_id);
+      r.detect_ms = timeForward(det, det_blob, iterations, det_out);
+
+      cv::dnn::Net rec = cv::dnn::readNet(recognition.path);
+      rec.setPreferableBackend(c.backend_id);
+      rec.setPreferableTarget(c.target_id);
+      r.recognize_ms = timeForward(rec, rec_blob, iterations, rec_out);
+
+      if (report.results.empty()) {
+        // First candidate is the CPU reference
+        det_ref = det_out;
+        rec_ref = rec_out;
+      }
+      r.max_error = std::max(relativeError(det_out, det_ref),
+                             relativeError(rec_out, rec_ref));
+      r.ok = r.max_error <= (isFP16(c.target_id) ? kMaxErrorFP16 : kMaxError);
+      if (!r.ok)
+        r.error = "output differs from CPU";
+    } catch (const cv::Exception &e) {
+      r.error = e.what();
+    }
+    report.results.push_back(r);
+  }
+  return report;
+}
+
+bool loadProbeReport(const std::string &path, const std::string &key,
+                     ProbeReport &report) {
+  std::ifstream in(path);
+  if (!in.is_open())
+    return false;
+  try {
+    json j;
+    in >> j;
+    if (j.value("key", "") != key)
+      return false;
+    ProbeReport loaded;
+    loaded.key = key;
+    for (const auto &item : j.at("results")) {
+      ProbeResult r;
+      r.name = item.value("name", "");
+      r.backend_id = item.value("backend", 0);
+      r.target_id = item.value("target", 0);
+      r.ok = item.value("ok", false);
+      r.error = item.value("error", "");
+      r.detect_ms = item.value("detect_ms", 0.0);
+      r.recognize_ms = item.value("recognize_ms", 0.0);
+      r.max_error = item.value("max_error", 0.0);
+      loaded.results.push_back(r);
+    }
+    report = loaded;
+  } catch (const json::exception &) {
+    return false;
+  }
+  return true;
+}
+
+bool saveProbeReport(const std::string &path, const ProbeReport &report) {
+  json j;
+  j["key"] = report.key;
+  j["results"] = json::array();
+  for (const auto &r : report.results) {
+    j["results"].push_back({{"name", r.name},
+                            {"backend", r.backend_id},
+                            {"target", r.target_id},
+                            {"ok", r.ok},
+                            {"error", r.error},
+                            {"detect_ms", r.detect_ms},
+                            {"recognize_ms", r.recognize_ms},
+                            {"max_error", r.max_error}});
+  }
+  std::error_code ec;
+  fs::create_directories(fs::path(path).parent_path(), ec);
+  std::ofstream out(path);
+  if (!out.is_open())
+    return false;
+  out << j.dump(2) << std::endl;
+  return out.good();
+}
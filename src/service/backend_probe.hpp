@@ -0,0 +1,63 @@
+#pragma once
+
+#include "model_registry.hpp"
+
+#include <string>
+#include <vector>
+
+// A cv::dnn backend/target pair the daemon may run on
+struct BackendCandidate {
+  std::string name; // "CPU", "OpenCL", "OpenCL-FP16", "OpenVINO", "CUDA", ...
+  int backend_id = 0;
+  int target_id = 0;
+};
+
+// Provider name ("cpu", "opencl", "openvino", "cuda"; case-insensitive) to the
+// pairs it covers. Unknown names give an empty list.
+std::vector<BackendCandidate> providerCandidates(const std::string &provider);
+
+// Pairs this OpenCV build reports via cv::dnn::getAvailableBackends(),
+// restricted to ones with a usable device (OpenCL platform, CUDA GPU).
+// The plain CPU pair is always first.
+std::vector<BackendCandidate> availableBackends();
+bool isBackendAvailable(const BackendCandidate &candidate);
+
+struct ProbeResult {
+  std::string name;
+  int backend_id = 0;
+  int target_id = 0;
+  bool ok = false;           // Ran and matched the CPU reference
+  std::string error;         // Why not, if !ok
+  double detect_ms = 0.0;    // Median forward time, detector
+  double recognize_ms = 0.0; // Median forward time, recognizer
+  double max_error = 0.0;    // Largest relative output deviation from CPU
+
+  double totalMs() const { return detect_ms + recognize_ms; }
+};
+
+struct ProbeReport {
+  std::string key; // See probeKey()
+  std::vector<ProbeResult> results;
+
+  // Fastest result that passed, or nullptr (also when the CPU reference,
+  // the first result, failed)
+  const ProbeResult *best() const;
+};
+
+// Identifies when a stored report is still valid: OpenCV version, CPU model,
+// OpenCL device and driver, and the model versions that were timed.
+std::string probeKey(const ModelSpec &detection, const ModelSpec &recognition);
+
+// Times detector and recognizer forward passes on synthetic input for every
+// candidate, after one untimed pass (graph setup, kernel builds). Outputs are
+// compared against the CPU pair, which must come first in `candidates`.
+ProbeReport probeBackends(const ModelSpec &detection,
+                          const ModelSpec &recognition,
+                          const std::vector<BackendCandidate> &candidates,
+                          int iterations = 10);
+
+// Stored report for `key`. False if the file is missing, unreadable or was
+// written for a different key.
+bool loadProbeReport(const std::string &path, const std::string &key,
+                     ProbeReport &report);
+bool saveProbeReport(const std::string &path, const ProbeReport &report);
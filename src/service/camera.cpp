@@ -1,6 +1,7 @@
 #include "camera.hpp"
 
 #include "constants.hpp"
+#include "image_ops.hpp"
 
 #include <cstdlib>
 #include <fcntl.h>
@@ -84,9 +85,41 @@ bool Camera::openAndWarmup(cv::VideoCapture &temp_cap) {
     std::this_thread::sleep_for(std::chrono::milliseconds(750));
   }
 
+  phase_.reset(); // New session, unrelated strobe phase
   return true;
 }
 
+void Camera::discardWarmup(cv::VideoCapture &temp_cap) {
+  // Discard initial frames for auto-exposure settling. On IR cameras they
+  // also teach the phase tracker the emitter's strobe pattern.
+  cv::Mat frame;
+  for (int i = 0; i < 10; i++) {
+    temp_cap.read(frame);
+    if (is_ir_camera && emitter_sync_ && !frame.empty())
+      phase_.observe(EmitterPhaseTracker::sampleBrightness(frame));
+  }
+}
+
+bool Camera::readLit(cv::VideoCapture &temp_cap, cv::Mat &frame) {
+  if (!is_ir_camera || !emitter_sync_)
+    return temp_cap.read(frame);
+
+  // Bounded, so a misbehaving emitter degrades to the old behavior (use
+  // whatever frame comes next) instead of stalling verification
+  for (int attempt = 0; attempt < 8; attempt++) {
+    if (!phase_.predictNextLit()) {
+      temp_cap.grab(); // Dequeue without decoding
+      phase_.skip();
+      continue;
+    }
+    if (!temp_cap.read(frame) || frame.empty())
+      return false;
+    if (phase_.observe(EmitterPhaseTracker::sampleBrightness(frame)))
+      return true;
+  }
+  return !frame.empty();
+}
+
 cv::Mat Camera::capture() {
   cv::VideoCapture temp_cap;
   if (!openAndWarmup(temp_cap)) {
@@ -94,17 +127,40 @@ cv::Mat Camera::capture() {
     return cv::Mat();
   }
 
-  cv::Mat frame;
-  // Discard initial frames for auto-exposure settling
-  for (int i = 0; i < 10; i++)
-    temp_cap.read(frame); // Read and discard
+  discardWarmup(temp_cap);
 
   std::this_thread::sleep_for(std::chrono::milliseconds(100));
-  temp_cap.read(frame);
+  cv::Mat frame;
+  readLit(temp_cap, frame);
+
+  return frame.empty() ? cv::Mat() : frame.clone();
+}
 
+bool Camera::openStream() {
+  if (cap.isOpened())
+    return true;
+  if (!openAndWarmup(cap)) {
+    std::cerr << "[Camera] Failed to open stream " << device_path << std::endl;
+    return false;
+  }
+
+  discardWarmup(cap);
+  return true;
+}
+
+cv::Mat Camera::readFrame() {
+  if (!cap.isOpened())
+    return cv::Mat();
+  cv::Mat frame;
+  readLit(cap, frame);
   return frame.empty() ? cv::Mat() : frame.clone();
 }
 
+void Camera::closeStream() {
+  if (cap.isOpened())
+    cap.release();
+}
+
 cv::Mat Camera::captureAveraged(int num_frames) {
   cv::VideoCapture temp_cap;
   if (!openAndWarmup(temp_cap)) {
@@ -127,25 +183,22 @@ cv::Mat Camera::captureAveraged(int num_frames) {
       if (frames.empty()) {
         expected_size = f.size();
       }
-      if (f.size() == expected_size) {
-        cv::Mat f32;
-        f.convertTo(f32, CV_32FC3);
-        frames.push_back(f32);
-      }
+      if (f.size() == expected_size)
+        frames.push_back(f);
     }
   }
 
   if (frames.empty())
     return cv::Mat();
 
-  // Average
-  cv::Mat sum = cv::Mat::zeros(frames[0].size(), CV_32FC3);
-  for (const auto &f : frames)
-    sum += f;
-  sum /= static_cast<float>(frames.size());
-
   cv::Mat result;
-  sum.convertTo(result, CV_8UC3);
+  if (use_umat_) {
+    cv::UMat avg;
+    averageFrames(frames, avg);
+    avg.copyTo(result);
+  } else {
+    averageFrames(frames, result);
+  }
   std::cerr << "[Camera] Averaged " << frames.size() << " frames" << std::endl;
   return result;
 }
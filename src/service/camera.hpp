@@ -1,5 +1,7 @@
 #pragma once
 
+#include "emitter_phase.hpp"
+
 #include <opencv2/opencv.hpp>
 #include <string>
 
@@ -14,6 +16,12 @@ public:
   // Standard capture (for verification - fast)
   cv::Mat capture();
 
+  // Streaming capture (multi-frame verification): open and warm up once,
+  // then read consecutive frames until closeStream()
+  bool openStream();
+  cv::Mat readFrame();
+  void closeStream();
+
   // Enhanced capture methods (for enrollment - quality)
   cv::Mat captureAveraged(int num_frames = 5);
   cv::Mat captureHDR(); // Multi-exposure, requires manual exposure support
@@ -21,6 +29,13 @@ public:
   // Capability detection
   bool supportsManualExposure() const { return supports_manual_exposure_; }
 
+  // IR only: skip frames taken while a strobing emitter was dark
+  void setEmitterSync(bool enabled) { emitter_sync_ = enabled; }
+  int emitterPeriod() const { return phase_.period(); }
+
+  // Average frames on the OpenCL device (see image_ops.hpp)
+  void setUseUMat(bool enabled) { use_umat_ = enabled; }
+
 private:
   std::string device_path;
   std::string ir_emitter_path_;
@@ -28,7 +43,12 @@ private:
   bool is_ir_camera = false;
   bool supports_manual_exposure_ = false;
   cv::VideoCapture cap;
+  bool emitter_sync_ = true;
+  EmitterPhaseTracker phase_;
+  bool use_umat_ = false;
 
   bool detectExposureSupport();
   bool openAndWarmup(cv::VideoCapture &cap);
+  void discardWarmup(cv::VideoCapture &cap);
+  bool readLit(cv::VideoCapture &cap, cv::Mat &frame);
 };
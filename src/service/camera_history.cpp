@@ -0,0 +1,108 @@
+#include "camera_history.hpp"
+
+#include "json.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+void CameraStats::record(bool matched, double ms) {
+  if (attempts >= kMaxAttempts) {
+    attempts /= 2;
+    successes /= 2;
+  }
+  attempts++;
+  if (matched)
+    successes++;
+  latency_ms.push_back(ms);
+  if (latency_ms.size() > kWindow)
+    latency_ms.pop_front();
+}
+
+double CameraStats::successRate() const {
+  return (successes + 1.0) / (attempts + 2.0);
+}
+
+double CameraStats::medianLatency() const {
+  if (latency_ms.empty())
+    return 0.0;
+  std::vector<double> sorted(latency_ms.begin(), latency_ms.end());
+  std::sort(sorted.begin(), sorted.end());
+  const size_t mid = sorted.size() / 2;
+  return sorted.size() % 2 ? sorted[mid] : (sorted[mid - 1] + sorted[mid]) / 2;
+}
+
+const CameraStats *CameraHistory::find(const std::string &id) const {
+  auto it = stats_.find(id);
+  return it == stats_.end() ? nullptr : &it->second;
+}
+
+std::vector<size_t> CameraHistory::order(const std::vector<std::string> &ids,
+                                         bool lenient) const {
+  // Expected wait for the deciding outcome: median latency divided by the
+  // chance that this camera produces it
+  auto cost = [&](size_t i) {
+    const CameraStats *s = find(ids[i]);
+    if (!s || s->latency_ms.empty())
+      return std::numeric_limits<double>::infinity();
+    double p = lenient ? s->successRate() : 1.0 - s->successRate();
+    return s->medianLatency() / p;
+  };
+  std::vector<double> costs;
+  std::vector<size_t> idx;
+  for (size_t i = 0; i < ids.size(); i++) {
+    costs.push_back(cost(i));
+    idx.push_back(i);
+  }
+  std::stable_sort(idx.begin(), idx.end(), [&costs](size_t a, size_t b) {
+    return costs[a] < costs[b];
+  });
+  return idx;
+}
+
+bool CameraHistory::load(const std::string &path) {
+  std::ifstream in(path);
+  if (!in.is_open())
+    return false;
+  try {
+    json j;
+    in >> j;
+    std::map<std::string, CameraStats> stats;
+    for (const auto &[id, item] : j.at("cameras").items()) {
+      CameraStats s;
+      s.attempts = item.value("attempts", 0);
+      s.successes = std::min(item.value("successes", 0), s.attempts);
+      for (double ms : item.value("latency_ms", std::vector<double>()))
+        s.latency_ms.push_back(ms);
+      while (s.latency_ms.size() > CameraStats::kWindow)
+        s.latency_ms.pop_front();
+      stats[id] = s;
+    }
+    stats_.swap(stats);
+  } catch (const json::exception &) {
+    return false;
+  }
+  return true;
+}
+
+bool CameraHistory::save(const std::string &path) const {
+  json j;
+  j["cameras"] = json::object();
+  for (const auto &[id, s] : stats_) {
+    std::vector<double> latency(s.latency_ms.begin(), s.latency_ms.end());
+    j["cameras"][id] = {{"attempts", s.attempts},
+                        {"successes", s.successes},
+                        {"latency_ms", latency}};
+  }
+  std::error_code ec;
+  fs::create_directories(fs::path(path).parent_path(), ec);
+  std::ofstream out(path);
+  if (!out.is_open())
+    return false;
+  out << j.dump(2) << std::endl;
+  return out.good();
+}
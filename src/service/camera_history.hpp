@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+// Outcome and time-to-decision of one camera over recent verifications
+struct CameraStats {
+  int attempts = 0;
+  int successes = 0;
+  std::deque<double> latency_ms; // Recent times to decision, newest last
+
+  void record(bool matched, double ms);
+  // Laplace-smoothed, 0.5 without history
+  double successRate() const;
+  // Median of the recent latencies, 0 without history
+  double medianLatency() const;
+
+  // Recent runs only, so the stats follow a camera that got better or worse
+  static constexpr int kMaxAttempts = 64;
+  static constexpr size_t kWindow = 32;
+};
+
+// Per-camera history, persisted as JSON between daemon runs. It ranks the
+// cameras by expected time to a decision: under a lenient policy the first
+// match decides, otherwise the first failure does.
+class CameraHistory {
+public:
+  CameraStats &at(const std::string &id) { return stats_[id]; }
+  const CameraStats *find(const std::string &id) const;
+
+  // Indices into `ids`, the camera expected to decide soonest first.
+  // Cameras without history keep their configured order, after the others.
+  std::vector<size_t> order(const std::vector<std::string> &ids,
+                            bool lenient) const;
+
+  // False if the file is missing or unreadable (the history stays empty)
+  bool load(const std::string &path);
+  bool save(const std::string &path) const;
+
+private:
+  std::map<std::string, CameraStats> stats_;
+};
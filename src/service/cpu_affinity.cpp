@@ -0,0 +1,170 @@
+#include "cpu_affinity.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <fstream>
+#include <pthread.h>
+#include <sched.h>
+#include <sstream>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+long readNumber(const std::string &path) {
+  std::ifstream f(path);
+  long v = -1;
+  if (!(f >> v))
+    return -1;
+  return v;
+}
+
+pid_t threadId() { return static_cast<pid_t>(syscall(SYS_gettid)); }
+} // namespace
+
+std::vector<int> parseCpuList(const std::string &list) {
+  std::vector<int> cpus;
+  std::stringstream ss(list);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    item.erase(std::remove_if(item.begin(), item.end(), ::isspace),
+               item.end());
+    if (item.empty())
+      continue;
+    try {
+      size_t used = 0;
+      auto dash = item.find('-');
+      int lo = std::stoi(item.substr(0, dash), &used);
+      if (used != (dash == std::string::npos ? item.size() : dash))
+        return {};
+      int hi = lo;
+      if (dash != std::string::npos) {
+        std::string tail = item.substr(dash + 1);
+        hi = std::stoi(tail, &used);
+        if (used != tail.size())
+          return {};
+      }
+      if (lo < 0 || hi < lo || hi >= CPU_SETSIZE)
+        return {};
+      for (int c = lo; c <= hi; c++)
+        cpus.push_back(c);
+    } catch (...) {
+      return {};
+    }
+  }
+  std::sort(cpus.begin(), cpus.end());
+  cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+  return cpus;
+}
+
+std::string formatCpuList(const std::vector<int> &cpus) {
+  std::string out;
+  for (size_t i = 0; i < cpus.size();) {
+    size_t j = i;
+    while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1)
+      j++;
+    if (!out.empty())
+      out += ",";
+    out += std::to_string(cpus[i]);
+    if (j > i)
+      out += "-" + std::to_string(cpus[j]);
+    i = j + 1;
+  }
+  return out;
+}
+
+std::vector<int> fastestCpus(const std::string &sysfs_cpu) {
+  std::ifstream f(sysfs_cpu + "/online");
+  std::string online;
+  std::getline(f, online);
+  std::vector<int> cpus = parseCpuList(online);
+
+  for (const char *attr : {"cpu_capacity", "cpufreq/cpuinfo_max_freq"}) {
+    std::vector<long> rank;
+    long best = 0;
+    for (int c : cpus) {
+      long v = readNumber(sysfs_cpu + "/cpu" + std::to_string(c) + "/" + attr);
+      rank.push_back(v);
+      best = std::max(best, v);
+    }
+    if (best <= 0)
+      continue;
+    std::vector<int> fastest;
+    for (size_t i = 0; i < cpus.size(); i++) {
+      if (rank[i] * 100 >= best * 95)
+        fastest.push_back(cpus[i]);
+    }
+    return fastest;
+  }
+  return cpus;
+}
+
+SchedMode parseSchedMode(const std::string &mode) {
+  if (mode == "nice")
+    return SchedMode::NICE;
+  if (mode == "fifo")
+    return SchedMode::FIFO;
+  return SchedMode::NORMAL;
+}
+
+bool setThreadAffinity(const std::vector<int> &cpus) {
+  if (cpus.empty())
+    return false;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int c : cpus)
+    CPU_SET(c, &set);
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+
+std::vector<int> threadAffinity() {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  std::vector<int> cpus;
+  if (sched_getaffinity(0, sizeof(set), &set) != 0)
+    return cpus;
+  for (int c = 0; c < CPU_SETSIZE; c++) {
+    if (CPU_ISSET(c, &set))
+      cpus.push_back(c);
+  }
+  return cpus;
+}
+
+ThreadTuning::ThreadTuning(const std::vector<int> &cpus, SchedMode mode,
+                           int fifo_priority, int nice_value) {
+  if (!cpus.empty()) {
+    saved_cpus_ = threadAffinity();
+    restore_affinity_ = setThreadAffinity(cpus);
+    ok_ = ok_ && restore_affinity_;
+  }
+  if (mode == SchedMode::FIFO) {
+    sched_param param{};
+    if (pthread_getschedparam(pthread_self(), &saved_policy_, &param) == 0) {
+      saved_priority_ = param.sched_priority;
+      param.sched_priority = fifo_priority;
+      restore_sched_ =
+          pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+    }
+    ok_ = ok_ && restore_sched_;
+  } else if (mode == SchedMode::NICE) {
+    // Per-thread on Linux when given the thread id
+    errno = 0;
+    saved_nice_ = getpriority(PRIO_PROCESS, threadId());
+    if (errno == 0)
+      restore_nice_ = setpriority(PRIO_PROCESS, threadId(), nice_value) == 0;
+    ok_ = ok_ && restore_nice_;
+  }
+}
+
+ThreadTuning::~ThreadTuning() {
+  if (restore_sched_) {
+    sched_param param{};
+    param.sched_priority = saved_priority_;
+    pthread_setschedparam(pthread_self(), saved_policy_, &param);
+  }
+  if (restore_nice_)
+    setpriority(PRIO_PROCESS, threadId(), saved_nice_);
+  if (restore_affinity_)
+    setThreadAffinity(saved_cpus_);
+}
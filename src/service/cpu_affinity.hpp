@@ -0,0 +1,56 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// CPU placement and scheduling for the pipeline stages. On hybrid (P/E
+// core) laptops the scheduler may run inference on efficiency cores, and a
+// busy system can delay the thread that dequeues camera frames.
+
+// "0-3,8,10-11" -> {0,1,2,3,8,10,11}. Empty on malformed input.
+std::vector<int> parseCpuList(const std::string &list);
+std::string formatCpuList(const std::vector<int> &cpus);
+
+// Online CPUs with the highest capacity (cpu_capacity, as exported on
+// heterogeneous systems) or, failing that, the highest cpuinfo_max_freq;
+// CPUs within 5% of the best count as equally fast. All online CPUs when
+// the topology carries no such information.
+std::vector<int> fastestCpus(
+    const std::string &sysfs_cpu = "/sys/devices/system/cpu");
+
+enum class SchedMode {
+  NORMAL, // Leave as is
+  NICE,   // SCHED_OTHER with raised priority (negative nice value)
+  FIFO,   // Real-time SCHED_FIFO; needs CAP_SYS_NICE
+};
+
+// "normal" / "nice" / "fifo"; NORMAL for anything else
+SchedMode parseSchedMode(const std::string &mode);
+
+// Affinity, policy and nice value of the calling thread. Changes apply on
+// construction and are undone on destruction; settings that the kernel
+// refuses (missing privileges, CPUs offline) are skipped, see ok().
+class ThreadTuning {
+public:
+  ThreadTuning(const std::vector<int> &cpus, SchedMode mode,
+               int fifo_priority = 10, int nice_value = -10);
+  ~ThreadTuning();
+  ThreadTuning(const ThreadTuning &) = delete;
+  ThreadTuning &operator=(const ThreadTuning &) = delete;
+
+  bool ok() const { return ok_; }
+
+private:
+  bool ok_ = true;
+  bool restore_affinity_ = false;
+  bool restore_sched_ = false;
+  bool restore_nice_ = false;
+  std::vector<int> saved_cpus_;
+  int saved_policy_ = 0;
+  int saved_priority_ = 0;
+  int saved_nice_ = 0;
+};
+
+// Pin the calling thread (and threads it creates later) to `cpus`
+bool setThreadAffinity(const std::vector<int> &cpus);
+std::vector<int> threadAffinity();
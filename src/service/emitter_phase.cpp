@@ -0,0 +1,98 @@
+#include "emitter_phase.hpp"
+
+#include <algorithm>
+
+namespace {
+constexpr float kLevelRate = 0.2f; // EMA rate of the lit/dark levels
+} // namespace
+
+float EmitterPhaseTracker::sampleBrightness(const cv::Mat &frame, int step) {
+  if (frame.empty() || frame.depth() != CV_8U)
+    return 0.0f;
+  const int cn = frame.channels();
+  unsigned long sum = 0;
+  unsigned long count = 0;
+  for (int y = step / 2; y < frame.rows; y += step) {
+    const uchar *row = frame.ptr<uchar>(y);
+    for (int x = step / 2; x < frame.cols; x += step) {
+      sum += row[x * cn];
+      count++;
+    }
+  }
+  return count > 0 ? static_cast<float>(sum) / count : 0.0f;
+}
+
+bool EmitterPhaseTracker::observe(float brightness) {
+  if (!patternLit())
+    skipped_ = 0; // The recheck asked for by predictNextLit()
+  if (!has_levels_) {
+    lit_level_ = dark_level_ = brightness;
+    has_levels_ = true;
+  }
+  lit_level_ = std::max(lit_level_, brightness);
+  dark_level_ = std::min(dark_level_, brightness);
+
+  bool lit = true;
+  if (lit_level_ - dark_level_ >= min_contrast_) {
+    float mid = 0.5f * (lit_level_ + dark_level_);
+    lit = brightness >= mid;
+    // Follow exposure changes without letting a single outlier stick
+    if (lit)
+      lit_level_ += kLevelRate * (brightness - lit_level_);
+    else
+      dark_level_ += kLevelRate * (brightness - dark_level_);
+  }
+
+  push(lit);
+  return lit;
+}
+
+void EmitterPhaseTracker::skip() {
+  skipped_++;
+  push(false);
+}
+
+bool EmitterPhaseTracker::patternLit() const {
+  if (period_ == 0 || history_.size() < static_cast<size_t>(period_))
+    return true;
+  return history_[history_.size() - period_];
+}
+
+bool EmitterPhaseTracker::predictNextLit() const {
+  return patternLit() || skipped_ >= recheck_skips_;
+}
+
+void EmitterPhaseTracker::reset() {
+  skipped_ = 0;
+  has_levels_ = false;
+  lit_level_ = dark_level_ = 0.0f;
+  period_ = 0;
+  history_.clear();
+}
+
+void EmitterPhaseTracker::push(bool lit) {
+  history_.push_back(lit);
+  while (history_.size() > static_cast<size_t>(4 * max_period_))
+    history_.pop_front();
+  learnPeriod();
+}
+
+void EmitterPhaseTracker::learnPeriod() {
+  period_ = 0;
+  const size_t n = history_.size();
+  if (std::find(history_.begin(), history_.end(), false) == history_.end())
+    return; // Never dark: nothing to skip
+
+  // Smallest period that explains at least two full cycles of history
+  for (int p = 2; p <= max_period_; p++) {
+    if (n < static_cast<size_t>(2 * p))
+      break;
+    bool repeats = true;
+    for (size_t i = p; i < n && repeats; i++)
+      repeats = history_[i] == history_[i - p];
+    if (repeats) {
+      period_ = p;
+      return;
+    }
+  }
+}
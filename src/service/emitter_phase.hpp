@@ -0,0 +1,52 @@
+#pragma once
+
+#include <deque>
+#include <opencv2/core.hpp>
+
+// Lit/unlit classification for IR cameras whose emitter strobes, so that
+// alternate frames (or one in every few) are dark. Each frame is reduced to
+// a subsampled brightness value and compared against running estimates of
+// the lit and dark levels; the recent lit/dark pattern is then searched for
+// a repeating period so dark frames can be skipped without decoding them.
+class EmitterPhaseTracker {
+public:
+  explicit EmitterPhaseTracker(float min_contrast = 12.0f, int max_period = 6,
+                               int recheck_skips = 8)
+      : min_contrast_(min_contrast), max_period_(max_period),
+        recheck_skips_(recheck_skips) {}
+
+  // Mean of every `step`-th pixel in each direction (first channel only)
+  static float sampleBrightness(const cv::Mat &frame, int step = 8);
+
+  // Classify the next frame; returns true if it is lit. Until the lit and
+  // dark levels differ by at least min_contrast, every frame counts as lit
+  // (emitter always on, or not strobing at all).
+  bool observe(float brightness);
+  // Account for a frame that was grabbed but not read because
+  // predictNextLit() returned false
+  void skip();
+  // False only when a learned period says the next frame will be dark.
+  // After recheck_skips skipped frames it asks for a predicted-dark frame
+  // to be read anyway: skipped frames are recorded as dark unseen, so only
+  // such a check can notice that the emitter stopped strobing.
+  bool predictNextLit() const;
+
+  // Strobe period in frames, 0 if no repeating pattern has been seen
+  int period() const { return period_; }
+  void reset();
+
+private:
+  float min_contrast_;
+  int max_period_;
+  int recheck_skips_;
+  int skipped_ = 0; // Frames skipped since a predicted-dark one was read
+  bool has_levels_ = false;
+  float lit_level_ = 0.0f;
+  float dark_level_ = 0.0f;
+  int period_ = 0;
+  std::deque<bool> history_; // Most recent last, true = lit
+
+  bool patternLit() const; // What the learned period alone predicts
+  void push(bool lit);
+  void learnPeriod();
+};
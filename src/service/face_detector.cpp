@@ -0,0 +1,319 @@
+#include "face_detector.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+
+namespace {
+// Input size of the detector that validates the model at construction
+const cv::Size kProbeSize(320, 320);
+} // namespace
+
+float letterbox(const cv::Mat &src, cv::Size dst_size, cv::Mat &dst) {
+  float scale = std::min(static_cast<float>(dst_size.width) / src.cols,
+                         static_cast<float>(dst_size.height) / src.rows);
+  cv::Size scaled(std::max(1, cvRound(src.cols * scale)),
+                  std::max(1, cvRound(src.rows * scale)));
+  scaled.width = std::min(scaled.width, dst_size.width);
+  scaled.height = std::min(scaled.height, dst_size.height);
+
+  cv::Mat bgr;
+  if (src.channels() == 1)
+    cv::cvtColor(src, bgr, cv::COLOR_GRAY2BGR);
+  else
+    bgr = src;
+
+  dst = cv::Mat::zeros(dst_size, CV_8UC3);
+  cv::Mat roi = dst(cv::Rect(cv::Point(0, 0), scaled));
+  cv::resize(bgr, roi, scaled, 0, 0, cv::INTER_LINEAR);
+  return scale;
+}
+
+void rescaleFaces(cv::Mat &faces, float scale) {
+  if (faces.empty() || scale == 1.0f)
+    return;
+  // Columns 0-13 are pixel coordinates/sizes, column 14 is the score
+  for (int r = 0; r < faces.rows; r++) {
+    float *row = faces.ptr<float>(r);
+    for (int c = 0; c < 14; c++)
+      row[c] /= scale;
+  }
+}
+
+void offsetFaces(cv::Mat &faces, cv::Point2f offset) {
+  for (int r = 0; r < faces.rows; r++) {
+    float *row = faces.ptr<float>(r);
+    row[0] += offset.x;
+    row[1] += offset.y;
+    for (int k = 0; k < 5; k++) {
+      row[4 + 2 * k] += offset.x;
+      row[5 + 2 * k] += offset.y;
+    }
+  }
+}
+
+DetectorCache::DetectorCache(const std::string &model_path,
+                             float score_threshold, float nms_threshold,
+                             int top_k, int backend_id, int target_id,
+                             size_t capacity, std::vector<uchar> model_buffer)
+    : model_path_(model_path), model_buffer_(std::move(model_buffer)),
+      score_threshold_(score_threshold), nms_threshold_(nms_threshold),
+      top_k_(top_k), backend_id_(backend_id), target_id_(target_id),
+      capacity_(std::max<size_t>(1, capacity)) {
+#if CV_VERSION_MAJOR > 4 || (CV_VERSION_MAJOR == 4 && CV_VERSION_MINOR >= 8)
+  if (model_buffer_.empty()) {
+    std::ifstream f(model_path_, std::ios::binary);
+    model_buffer_.assign(std::istreambuf_iterator<char>(f),
+                         std::istreambuf_iterator<char>());
+  }
+#else
+  model_buffer_.clear(); // No buffer-based FaceDetectorYN::create
+#endif
+  // Fail early (like FaceDetectorYN::create) if the model can't be loaded
+  probe_ = create(kProbeSize);
+}
+
+cv::Ptr<cv::FaceDetectorYN> DetectorCache::get(cv::Size size) {
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    if (it->first == size) {
+      entries_.splice(entries_.begin(), entries_, it);
+      return entries_.front().second;
+    }
+  }
+
+  cv::Ptr<cv::FaceDetectorYN> det =
+      probe_ && size == kProbeSize ? probe_ : create(size);
+  probe_.release();
+  entries_.emplace_front(size, det);
+  if (entries_.size() > capacity_)
+    entries_.pop_back();
+  return det;
+}
+
+cv::Ptr<cv::FaceDetectorYN> DetectorCache::create(cv::Size size) const {
+  cv::Ptr<cv::FaceDetectorYN> det;
+#if CV_VERSION_MAJOR > 4 || (CV_VERSION_MAJOR == 4 && CV_VERSION_MINOR >= 8)
+  if (!model_buffer_.empty()) {
+    det = cv::FaceDetectorYN::create("onnx", model_buffer_, {}, size,
+                                     score_threshold_, nms_threshold_, top_k_,
+                                     backend_id_, target_id_);
+  }
+#endif
+  if (!det) {
+    det = cv::FaceDetectorYN::create(model_path_, "", size, score_threshold_,
+                                     nms_threshold_, top_k_, backend_id_,
+                                     target_id_);
+  }
+  return det;
+}
+
+std::vector<cv::Size> DetectorCache::sizes() const {
+  std::vector<cv::Size> out;
+  for (const auto &entry : entries_)
+    out.push_back(entry.first);
+  return out;
+}
+
+void DetectorCache::detect(cv::InputArray frame, cv::Mat &faces) {
+  get(frame.size())->detect(frame, faces);
+}
+
+void detectCoarseToFine(DetectorCache &detector, const cv::Mat &frame,
+                        cv::Size coarse_size, cv::Size fine_size,
+                        float roi_expand, float nms_threshold, cv::Mat &faces) {
+  faces.release();
+  if (frame.empty())
+    return;
+
+  // Stage 1: whole frame at a tiny input
+  cv::Mat coarse_input, coarse;
+  float coarse_scale = letterbox(frame, coarse_size, coarse_input);
+  detector.detect(coarse_input, coarse);
+  if (coarse.empty())
+    return;
+  rescaleFaces(coarse, coarse_scale);
+
+  // Stage 2: re-detect around each coarse face
+  const cv::Rect frame_rect(0, 0, frame.cols, frame.rows);
+  cv::Mat merged;
+  for (int i = 0; i < coarse.rows; i++) {
+    const float *c = coarse.ptr<float>(i);
+    float side = std::max(c[2], c[3]) * roi_expand;
+    cv::Point2f center(c[0] + c[2] / 2, c[1] + c[3] / 2);
+    cv::Rect roi = cv::Rect(cvRound(center.x - side / 2),
+                            cvRound(center.y - side / 2), cvRound(side),
+                            cvRound(side)) &
+                   frame_rect;
+    if (roi.area() <= 0)
+      continue;
+
+    cv::Mat fine_input, fine;
+    float fine_scale = letterbox(frame(roi), fine_size, fine_input);
+    detector.detect(fine_input, fine);
+    if (fine.empty()) {
+      merged.push_back(coarse.row(i));
+      continue;
+    }
+    rescaleFaces(fine, fine_scale);
+    offsetFaces(fine, cv::Point2f(static_cast<float>(roi.x),
+                                  static_cast<float>(roi.y)));
+    merged.push_back(fine);
+  }
+
+  if (merged.rows <= 1) {
+    faces = merged;
+    return;
+  }
+
+  // Overlapping ROIs can yield the same face twice
+  std::vector<cv::Rect2i> boxes;
+  std::vector<float> scores;
+  for (int r = 0; r < merged.rows; r++) {
+    const float *m = merged.ptr<float>(r);
+    boxes.emplace_back(int(m[0]), int(m[1]), int(m[2]), int(m[3]));
+    scores.push_back(m[14]);
+  }
+  std::vector<int> keep;
+  cv::dnn::NMSBoxes(boxes, scores, 0.0f, nms_threshold, keep);
+  for (int idx : keep)
+    faces.push_back(merged.row(idx));
+}
+
+BatchFaceDetector::BatchFaceDetector(const std::string &model_path,
+                                     cv::Size input_size, float score_threshold,
+                                     float nms_threshold, int top_k,
+                                     int backend_id, int target_id,
+                                     const std::vector<uchar> &model_buffer)
+    : input_size_(input_size), score_threshold_(score_threshold),
+      nms_threshold_(nms_threshold), top_k_(top_k) {
+  if (model_buffer.empty())
+    net_ = cv::dnn::readNet(model_path);
+  else
+    net_ = cv::dnn::readNetFromONNX(model_buffer);
+  net_.setPreferableBackend(backend_id);
+  net_.setPreferableTarget(target_id);
+  generatePriors();
+}
+
+void BatchFaceDetector::generatePriors() {
+  const int in_w = input_size_.width;
+  const int in_h = input_size_.height;
+
+  // Feature map strides 8/16/32/64, as in cv::FaceDetectorYN
+  cv::Size fm2((in_w + 1) / 2 / 2, (in_h + 1) / 2 / 2);
+  cv::Size fm3(fm2.width / 2, fm2.height / 2);
+  cv::Size fm4(fm3.width / 2, fm3.height / 2);
+  cv::Size fm5(fm4.width / 2, fm4.height / 2);
+  cv::Size fm6(fm5.width / 2, fm5.height / 2);
+  const std::vector<cv::Size> feature_maps = {fm3, fm4, fm5, fm6};
+
+  const std::vector<std::vector<float>> min_sizes = {
+      {10.0f, 16.0f, 24.0f}, {32.0f, 48.0f}, {64.0f, 96.0f},
+      {128.0f, 192.0f, 256.0f}};
+  const std::vector<int> steps = {8, 16, 32, 64};
+
+  priors_.clear();
+  for (size_t i = 0; i < feature_maps.size(); ++i) {
+    for (int h = 0; h < feature_maps[i].height; ++h) {
+      for (int w = 0; w < feature_maps[i].width; ++w) {
+        for (float min_size : min_sizes[i]) {
+          float cx = (w + 0.5f) * steps[i] / in_w;
+          float cy = (h + 0.5f) * steps[i] / in_h;
+          priors_.emplace_back(cx, cy, min_size / in_w, min_size / in_h);
+        }
+      }
+    }
+  }
+}
+
+cv::Mat BatchFaceDetector::decode(const float *loc, const float *conf,
+                                  const float *iou) const {
+  const float variance[] = {0.1f, 0.2f};
+  const float in_w = static_cast<float>(input_size_.width);
+  const float in_h = static_cast<float>(input_size_.height);
+
+  cv::Mat faces;
+  std::vector<cv::Rect2i> boxes;
+  std::vector<float> scores;
+  cv::Mat face(1, 15, CV_32F);
+
+  for (size_t i = 0; i < priors_.size(); ++i) {
+    const cv::Rect2f &p = priors_[i];
+    const float *l = loc + i * 14;
+
+    float iou_score = std::min(1.0f, std::max(0.0f, iou[i]));
+    float score = std::sqrt(conf[i * 2 + 1] * iou_score);
+    if (score < score_threshold_)
+      continue;
+
+    float cx = (p.x + l[0] * variance[0] * p.width) * in_w;
+    float cy = (p.y + l[1] * variance[0] * p.height) * in_h;
+    float w = p.width * std::exp(l[2] * variance[0]) * in_w;
+    float h = p.height * std::exp(l[3] * variance[1]) * in_h;
+
+    float *f = face.ptr<float>(0);
+    f[0] = cx - w / 2;
+    f[1] = cy - h / 2;
+    f[2] = w;
+    f[3] = h;
+    for (int k = 0; k < 5; k++) {
+      f[4 + 2 * k] = (p.x + l[4 + 2 * k] * variance[0] * p.width) * in_w;
+      f[5 + 2 * k] = (p.y + l[5 + 2 * k] * variance[0] * p.height) * in_h;
+    }
+    f[14] = score;
+
+    faces.push_back(face);
+    boxes.emplace_back(int(f[0]), int(f[1]), int(f[2]), int(f[3]));
+    scores.push_back(score);
+  }
+
+  if (faces.rows <= 1)
+    return faces;
+
+  std::vector<int> keep;
+  cv::dnn::NMSBoxes(boxes, scores, score_threshold_, nms_threshold_, keep, 1.f,
+                    top_k_);
+  cv::Mat nms_faces;
+  for (int idx : keep)
+    nms_faces.push_back(faces.row(idx));
+  return nms_faces;
+}
+
+bool BatchFaceDetector::detect(const std::vector<cv::Mat> &frames,
+                               std::vector<cv::Mat> &faces) {
+  faces.assign(frames.size(), cv::Mat());
+  if (frames.empty())
+    return true;
+
+  std::vector<cv::Mat> inputs(frames.size());
+  std::vector<float> scales(frames.size());
+  for (size_t i = 0; i < frames.size(); i++)
+    scales[i] = letterbox(frames[i], input_size_, inputs[i]);
+
+  // Same preprocessing as FaceDetectorYN (raw BGR, no mean/scale)
+  cv::Mat blob = cv::dnn::blobFromImages(inputs);
+  std::vector<cv::Mat> outputs;
+  try {
+    net_.setInput(blob);
+    net_.forward(outputs, std::vector<cv::String>{"loc", "conf", "iou"});
+  } catch (const cv::Exception &) {
+    return false;
+  }
+
+  // Outputs are flattened over the batch: [N * priors, 14|2|1]
+  const size_t n = frames.size();
+  const size_t p = priors_.size();
+  if (outputs.size() != 3 || outputs[0].total() != n * p * 14 ||
+      outputs[1].total() != n * p * 2 || outputs[2].total() != n * p)
+    return false;
+
+  const float *loc = outputs[0].ptr<float>();
+  const float *conf = outputs[1].ptr<float>();
+  const float *iou = outputs[2].ptr<float>();
+  for (size_t i = 0; i < n; i++) {
+    faces[i] = decode(loc + i * p * 14, conf + i * p * 2, iou + i * p);
+    rescaleFaces(faces[i], scales[i]);
+  }
+  return true;
+}
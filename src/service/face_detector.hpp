@@ -0,0 +1,99 @@
+#pragma once
+
+#include <list>
+#include <opencv2/dnn.hpp>
+#include <opencv2/opencv.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Resize `src` into a `dst_size` canvas keeping aspect ratio (padding the
+// right/bottom edge with black). Returns the scale applied to `src`.
+float letterbox(const cv::Mat &src, cv::Size dst_size, cv::Mat &dst);
+
+// Map face rows detected on a scaled image back to source coordinates.
+// Rows use the cv::FaceDetectorYN layout: box (4), landmarks (10), score.
+void rescaleFaces(cv::Mat &faces, float scale);
+
+// Shift face rows detected inside an ROI into full-frame coordinates.
+void offsetFaces(cv::Mat &faces, cv::Point2f offset);
+
+// Small LRU cache of cv::FaceDetectorYN instances keyed by input size.
+// setInputSize() reshapes the network and reallocates its buffers, so
+// alternating between IR and RGB resolutions (or HDR output) on a single
+// instance pays that cost on every frame. The ONNX bytes are read once (or
+// taken from `model_buffer`) and shared by all instances where OpenCV
+// supports buffer-based creation.
+class DetectorCache {
+public:
+  DetectorCache(const std::string &model_path, float score_threshold,
+                float nms_threshold, int top_k, int backend_id, int target_id,
+                size_t capacity = 4, std::vector<uchar> model_buffer = {});
+
+  // Detector configured for `size` (created on first use)
+  cv::Ptr<cv::FaceDetectorYN> get(cv::Size size);
+  void detect(cv::InputArray frame, cv::Mat &faces);
+
+  size_t size() const { return entries_.size(); }
+  // Cached input sizes, most recently used first
+  std::vector<cv::Size> sizes() const;
+
+private:
+  cv::Ptr<cv::FaceDetectorYN> create(cv::Size size) const;
+
+  std::string model_path_;
+  std::vector<uchar> model_buffer_;
+  float score_threshold_;
+  float nms_threshold_;
+  int top_k_;
+  int backend_id_;
+  int target_id_;
+  size_t capacity_;
+  // Most recently used first
+  std::list<std::pair<cv::Size, cv::Ptr<cv::FaceDetectorYN>>> entries_;
+  // Built by the constructor to validate the model. Kept out of entries_
+  // and dropped on the first get(), which reuses it if the size matches.
+  cv::Ptr<cv::FaceDetectorYN> probe_;
+};
+
+// Two-stage detection for faces that fill most of the frame.
+// Stage 1 runs YuNet on the whole frame letterboxed to `coarse_size`
+// (e.g. 160x120). Only if that finds a face, stage 2 re-detects on an ROI
+// around it (box expanded by `roi_expand`) letterboxed to `fine_size`, which
+// gives precise landmarks at a fraction of a full-resolution pass. Coarse
+// faces the fine pass misses are kept as-is. Output is in frame coordinates.
+void detectCoarseToFine(DetectorCache &detector, const cv::Mat &frame,
+                        cv::Size coarse_size, cv::Size fine_size,
+                        float roi_expand, float nms_threshold, cv::Mat &faces);
+
+// YuNet over several frames in a single batched forward pass.
+// Frames (e.g. IR + RGB) are letterboxed to one shared input size so the
+// network is never reshaped between cameras. Decoding mirrors
+// cv::FaceDetectorYN for the 2022mar model.
+class BatchFaceDetector {
+public:
+  // Built from `model_buffer` when given, otherwise from `model_path`
+  BatchFaceDetector(const std::string &model_path, cv::Size input_size,
+                    float score_threshold, float nms_threshold, int top_k,
+                    int backend_id, int target_id,
+                    const std::vector<uchar> &model_buffer = {});
+
+  // Fills one face matrix per frame, in source-frame coordinates.
+  // Returns false if the network rejected the batch (models exported with a
+  // fixed batch dimension); callers should fall back to per-frame detection.
+  [[nodiscard]] bool detect(const std::vector<cv::Mat> &frames,
+                            std::vector<cv::Mat> &faces);
+
+  cv::Size inputSize() const { return input_size_; }
+
+private:
+  cv::dnn::Net net_;
+  cv::Size input_size_;
+  float score_threshold_;
+  float nms_threshold_;
+  int top_k_;
+  std::vector<cv::Rect2f> priors_;
+
+  void generatePriors();
+  cv::Mat decode(const float *loc, const float *conf, const float *iou) const;
+};
@@ -0,0 +1,72 @@
+#include "face_quality.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr float kRadToDeg = 180.0f / static_cast<float>(CV_PI);
+// Nose tip sits roughly 0.6 eye-distances in front of the eye plane, so its
+// sideways offset is about 0.6 * tan(yaw) eye-distances.
+constexpr float kNoseDepth = 0.6f;
+constexpr int kSharpnessWidth = 112; // Same scale as the aligned SFace crop
+} // namespace
+
+FaceQuality assessFaceQuality(const cv::Mat &frame, const cv::Mat &face) {
+  FaceQuality q;
+  const float *f = face.ptr<float>(0);
+
+  // Landmarks: right eye (4,5), left eye (6,7), nose tip (8,9)
+  cv::Point2f re(f[4], f[5]), le(f[6], f[7]), nose(f[8], f[9]);
+  cv::Point2f eye_vec = le - re;
+  q.interocular_px = std::sqrt(eye_vec.dot(eye_vec));
+  q.roll_deg = std::atan2(eye_vec.y, eye_vec.x) * kRadToDeg;
+
+  if (q.interocular_px > 0.0f) {
+    // Nose offset along the eye line, relative to the eye midpoint
+    cv::Point2f mid = (re + le) * 0.5f;
+    cv::Point2f axis = eye_vec / q.interocular_px;
+    float offset = (nose - mid).dot(axis) / q.interocular_px;
+    q.yaw_deg = std::atan(offset / kNoseDepth) * kRadToDeg;
+  }
+
+  cv::Rect roi =
+      cv::Rect(cvRound(f[0]), cvRound(f[1]), cvRound(f[2]), cvRound(f[3])) &
+      cv::Rect(0, 0, frame.cols, frame.rows);
+  if (roi.width < 2 || roi.height < 2)
+    return q;
+
+  cv::Mat gray;
+  if (frame.channels() == 1)
+    gray = frame(roi);
+  else
+    cv::cvtColor(frame(roi), gray, cv::COLOR_BGR2GRAY);
+  q.brightness = static_cast<float>(cv::mean(gray)[0]);
+
+  // Normalize size so the blur measure doesn't depend on face distance
+  cv::Mat scaled, lap;
+  double s = static_cast<double>(kSharpnessWidth) / gray.cols;
+  cv::resize(gray, scaled, cv::Size(), s, s, cv::INTER_AREA);
+  cv::Laplacian(scaled, lap, CV_32F);
+  cv::Scalar mean, stddev;
+  cv::meanStdDev(lap, mean, stddev);
+  q.sharpness = static_cast<float>(stddev[0] * stddev[0]);
+  return q;
+}
+
+std::string checkFaceQuality(const FaceQuality &q,
+                             const QualityLimits &limits) {
+  if (limits.min_interocular_px > 0 &&
+      q.interocular_px < limits.min_interocular_px)
+    return "face too small";
+  if (limits.max_roll_deg > 0 && std::abs(q.roll_deg) > limits.max_roll_deg)
+    return "head tilted";
+  if (limits.max_yaw_deg > 0 && std::abs(q.yaw_deg) > limits.max_yaw_deg)
+    return "head turned";
+  if (limits.min_brightness > 0 && q.brightness < limits.min_brightness)
+    return "face underexposed";
+  if (limits.max_brightness > 0 && q.brightness > limits.max_brightness)
+    return "face overexposed";
+  if (limits.min_sharpness > 0 && q.sharpness < limits.min_sharpness)
+    return "face blurred";
+  return "";
+}
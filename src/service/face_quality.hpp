@@ -0,0 +1,31 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <string>
+
+// Cheap per-face quality measures, computed between detection and alignment
+// so frames that cannot pass never reach the recognizer.
+struct FaceQuality {
+  float sharpness = 0.0f;      // Laplacian variance, face ROI at 112 px wide
+  float yaw_deg = 0.0f;        // Rough head turn from nose vs. eye midpoint
+  float roll_deg = 0.0f;       // Eye line tilt
+  float interocular_px = 0.0f; // Eye distance in frame pixels
+  float brightness = 0.0f;     // Mean ROI intensity (0-255)
+};
+
+// A limit of 0 disables that check
+struct QualityLimits {
+  float min_sharpness = 0.0f;
+  float max_yaw_deg = 0.0f;
+  float max_roll_deg = 0.0f;
+  float min_interocular_px = 0.0f;
+  float min_brightness = 0.0f;
+  float max_brightness = 0.0f;
+};
+
+// `face` is a FaceDetectorYN row: box (4), landmarks (10), score
+FaceQuality assessFaceQuality(const cv::Mat &frame, const cv::Mat &face);
+
+// Empty if the face passes, otherwise a short description of the first
+// failed check (for logs and diagnostics)
+std::string checkFaceQuality(const FaceQuality &q, const QualityLimits &limits);
@@ -0,0 +1,102 @@
+#include "face_tracker.hpp"
+
+#include "face_detector.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+constexpr float kPatchWidth = 64.0f;  // Template width after downscaling
+constexpr float kSearchMargin = 0.5f; // Search window margin (box widths)
+
+cv::Mat toGray(const cv::Mat &src) {
+  if (src.channels() == 1)
+    return src;
+  cv::Mat gray;
+  cv::cvtColor(src, gray, cv::COLOR_BGR2GRAY);
+  return gray;
+}
+} // namespace
+
+float alignmentChange(const cv::Mat &a, const cv::Mat &b) {
+  if (a.empty() || b.empty())
+    return std::numeric_limits<float>::infinity();
+  const float *pa = a.ptr<float>(0);
+  const float *pb = b.ptr<float>(0);
+  float max_shift = 0.0f;
+  for (int k = 0; k < 5; k++) {
+    float dx = pa[4 + 2 * k] - pb[4 + 2 * k];
+    float dy = pa[5 + 2 * k] - pb[5 + 2 * k];
+    max_shift = std::max(max_shift, std::sqrt(dx * dx + dy * dy));
+  }
+  return pa[2] > 0.0f ? max_shift / pa[2]
+                      : std::numeric_limits<float>::infinity();
+}
+
+void FaceTracker::grabTemplate(const cv::Mat &frame) {
+  const float *f = face_.ptr<float>(0);
+  cv::Rect box = cv::Rect(cvRound(f[0]), cvRound(f[1]), cvRound(f[2]),
+                          cvRound(f[3])) &
+                 cv::Rect(0, 0, frame.cols, frame.rows);
+  if (box.width < 8 || box.height < 8) {
+    active_ = false;
+    return;
+  }
+  cv::resize(toGray(frame(box)), templ_, cv::Size(), scale_, scale_,
+             cv::INTER_AREA);
+  templ_tl_ = cv::Point2f(static_cast<float>(box.x), static_cast<float>(box.y));
+}
+
+void FaceTracker::init(const cv::Mat &frame, const cv::Mat &face) {
+  face_ = face.clone();
+  scale_ = std::min(1.0f, kPatchWidth / std::max(1.0f, face_.at<float>(0, 2)));
+  confidence_ = 1.0f;
+  active_ = true;
+  grabTemplate(frame);
+}
+
+bool FaceTracker::update(const cv::Mat &frame, cv::Mat &face) {
+  if (!active_ || frame.empty())
+    return false;
+
+  cv::Rect frame_rect(0, 0, frame.cols, frame.rows);
+  cv::Rect templ_box(cvRound(templ_tl_.x), cvRound(templ_tl_.y),
+                     cvRound(templ_.cols / scale_),
+                     cvRound(templ_.rows / scale_));
+  int mx = cvRound(templ_box.width * kSearchMargin);
+  int my = cvRound(templ_box.height * kSearchMargin);
+  cv::Rect search = cv::Rect(templ_box.x - mx, templ_box.y - my,
+                             templ_box.width + 2 * mx,
+                             templ_box.height + 2 * my) &
+                    frame_rect;
+
+  cv::Mat window;
+  cv::resize(toGray(frame(search)), window, cv::Size(), scale_, scale_,
+             cv::INTER_AREA);
+  if (window.cols < templ_.cols || window.rows < templ_.rows) {
+    active_ = false;
+    return false;
+  }
+
+  cv::Mat result;
+  cv::matchTemplate(window, templ_, result, cv::TM_CCOEFF_NORMED);
+  double max_val = 0.0;
+  cv::Point max_loc;
+  cv::minMaxLoc(result, nullptr, &max_val, nullptr, &max_loc);
+  confidence_ = static_cast<float>(max_val);
+  if (confidence_ < min_confidence_) {
+    active_ = false;
+    return false;
+  }
+
+  cv::Point2f new_tl(search.x + max_loc.x / scale_,
+                     search.y + max_loc.y / scale_);
+  offsetFaces(face_, new_tl - templ_tl_);
+  grabTemplate(frame); // Follow slow appearance changes
+  if (!active_)
+    return false;
+
+  face = face_.clone();
+  return true;
+}
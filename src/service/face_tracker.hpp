@@ -0,0 +1,39 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+
+// Largest landmark displacement between two face rows (FaceDetectorYN
+// layout), relative to the width of the first face's box. Used to decide
+// whether a tracked face needs to be re-aligned and re-recognized.
+float alignmentChange(const cv::Mat &a, const cv::Mat &b);
+
+// Follows one face between consecutive frames by template matching on a
+// small grayscale patch, so YuNet only has to run every few frames.
+// Box and the 5 landmarks are shifted by the matched displacement; scale
+// changes are left to the next full detection.
+class FaceTracker {
+public:
+  explicit FaceTracker(float min_confidence = 0.6f)
+      : min_confidence_(min_confidence) {}
+
+  // Start tracking from a detector result row
+  void init(const cv::Mat &frame, const cv::Mat &face);
+  // Track into `frame`. Returns false (and deactivates) when the match
+  // confidence drops below the minimum.
+  bool update(const cv::Mat &frame, cv::Mat &face);
+  void reset() { active_ = false; }
+
+  bool active() const { return active_; }
+  float confidence() const { return confidence_; }
+
+private:
+  float min_confidence_;
+  bool active_ = false;
+  float confidence_ = 0.0f;
+  float scale_ = 1.0f;     // Patch downscale so faces are ~64 px wide
+  cv::Mat face_;           // Current face row (frame coordinates)
+  cv::Mat templ_;          // Grayscale, scaled patch of the face box
+  cv::Point2f templ_tl_;   // Template origin in frame coordinates
+
+  void grabTemplate(const cv::Mat &frame);
+};
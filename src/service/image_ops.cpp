@@ -0,0 +1,48 @@
+#include "image_ops.hpp"
+
+namespace {
+template <typename M>
+void averageAs(const std::vector<cv::Mat> &frames, cv::OutputArray avg) {
+  M sum, src, f32;
+  for (const auto &f : frames) {
+    f.copyTo(src); // Upload for cv::UMat
+    src.convertTo(f32, CV_32F);
+    if (sum.empty())
+      sum = f32.clone();
+    else
+      cv::add(sum, f32, sum);
+  }
+  sum.convertTo(sum, -1, 1.0 / frames.size());
+  sum.convertTo(avg, CV_8U);
+}
+} // namespace
+
+double meanBrightness(cv::InputArray frame) {
+  if (frame.empty())
+    return 0.0;
+  cv::Scalar means = cv::mean(frame);
+  return (means[0] + means[1] + means[2]) / 3.0;
+}
+
+void averageFrames(const std::vector<cv::Mat> &frames, cv::OutputArray avg) {
+  if (frames.empty()) {
+    avg.release();
+    return;
+  }
+  if (avg.isUMat())
+    averageAs<cv::UMat>(frames, avg);
+  else
+    averageAs<cv::Mat>(frames, avg);
+}
+
+void alignFace(cv::FaceRecognizerSF &sf, cv::InputArray image,
+               const cv::Mat &face, cv::Mat &crop) {
+  if (!image.isUMat()) {
+    sf.alignCrop(image, face, crop);
+    return;
+  }
+  // warpAffine only takes its OpenCL path with a UMat destination
+  cv::UMat ucrop;
+  sf.alignCrop(image, face, ucrop);
+  ucrop.copyTo(crop);
+}
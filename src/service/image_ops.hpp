@@ -0,0 +1,32 @@
+#pragma once
+
+#include <opencv2/objdetect.hpp>
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+// Preprocessing through OpenCV's transparent API. With an OpenCL target the
+// engine uploads each frame once into a cv::UMat, and resizing, averaging,
+// brightness and face alignment then run on the device. Only small results
+// (downscaled detector input, 112x112 crops) return to host memory, where
+// cv::dnn builds its input blob. Given a cv::Mat, every helper runs exactly
+// the CPU code it replaced.
+
+// The device copy when there is one, otherwise the host frame
+inline cv::_InputArray frameInput(const cv::Mat &frame,
+                                  const cv::UMat &uframe) {
+  if (!uframe.empty())
+    return cv::_InputArray(uframe);
+  return cv::_InputArray(frame);
+}
+
+// Mean intensity over all channels (0-255), 0 for an empty frame
+double meanBrightness(cv::InputArray frame);
+
+// Per-pixel mean of same-sized 8-bit frames, accumulated in float. Computed
+// on the device when `avg` is a cv::UMat.
+void averageFrames(const std::vector<cv::Mat> &frames, cv::OutputArray avg);
+
+// cv::FaceRecognizerSF::alignCrop. For a cv::UMat image the warp runs on the
+// device and only the crop is downloaded.
+void alignFace(cv::FaceRecognizerSF &sf, cv::InputArray image,
+               const cv::Mat &face, cv::Mat &crop);
@@ -0,0 +1,35 @@
+#include "inference_watchdog.hpp"
+
+#include <algorithm>
+#include <vector>
+
+bool InferenceWatchdog::record(double ms) {
+  history_.push_back(ms);
+  if (history_.size() > kWindow)
+    history_.pop_front();
+  if (budget_ms_ <= 0.0 || ms <= budget_ms_) {
+    strikes_ = 0;
+    return false;
+  }
+  return ++strikes_ >= max_strikes_;
+}
+
+bool InferenceWatchdog::fail() {
+  failures_++;
+  return true;
+}
+
+void InferenceWatchdog::reset() {
+  strikes_ = 0;
+  failures_ = 0;
+  history_.clear();
+}
+
+double InferenceWatchdog::median() const {
+  if (history_.empty())
+    return 0.0;
+  std::vector<double> sorted(history_.begin(), history_.end());
+  std::nth_element(sorted.begin(), sorted.begin() + sorted.size() / 2,
+                   sorted.end());
+  return sorted[sorted.size() / 2];
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <utility>
+
+// Latency and failure tracking for one inference stage on the active
+// backend. A failure (exception, non-finite output) trips it at once; a
+// latency budget overrun only after `max_strikes` overruns in a row, so a
+// single hiccup (page fault, frequency ramp) doesn't cause a failover.
+class InferenceWatchdog {
+public:
+  explicit InferenceWatchdog(double budget_ms = 500.0, int max_strikes = 3)
+      : budget_ms_(budget_ms), max_strikes_(max_strikes) {}
+
+  // Record a successful run. True when the backend should be abandoned.
+  bool record(double ms);
+  // Record a failed run. Always true.
+  bool fail();
+  // Forget strikes and history (after switching backends)
+  void reset();
+
+  double budget() const { return budget_ms_; }
+  int strikes() const { return strikes_; }
+  int failures() const { return failures_; }
+  double last() const { return history_.empty() ? 0.0 : history_.back(); }
+  // Median of the most recent runs, 0 before the first one
+  double median() const;
+
+private:
+  static constexpr size_t kWindow = 32;
+
+  double budget_ms_;
+  int max_strikes_;
+  int strikes_ = 0;
+  int failures_ = 0;
+  std::deque<double> history_;
+};
+
+// Run a stage that may be retried on another backend. It works on a copy of
+// `state` that replaces the original only if the stage returns, so a retry
+// after a failure starts from exactly the input the failed run saw.
+template <typename State, typename Stage>
+void commitOnSuccess(State &state, Stage &&stage) {
+  State work = state;
+  stage(work);
+  state = std::move(work);
+}
@@ -46,6 +46,8 @@ void handle_client(int client_fd, AuthEngine &engine) {
   //      "ADD_USER vlad"
   //      "TRAIN_USER vlad"
   //      "TEST_AUTH"
+  //      "STATUS"
+  //      "MEMORY"
 
   std::string response = "ERROR Unknown Command";
 
@@ -81,6 +83,10 @@ void handle_client(int client_fd, AuthEngine &engine) {
 #else
       response = "Unknown";
 #endif
+    } else if (cmd == "STATUS") {
+      response = engine.statusReport();
+    } else if (cmd == "MEMORY") {
+      response = engine.memoryReport();
     } else if (cmd == "TEST_AUTH") {
       std::string user;
       iss >> user;
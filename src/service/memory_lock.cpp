@@ -0,0 +1,162 @@
+#include "memory_lock.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <fstream>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+namespace {
+size_t pageSize() {
+  static const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  return page;
+}
+
+// Soft RLIMIT_MEMLOCK after raising it to the hard limit
+size_t raiseMemlockLimit() {
+  struct rlimit rl;
+  if (getrlimit(RLIMIT_MEMLOCK, &rl) != 0)
+    return 0;
+  if (rl.rlim_cur < rl.rlim_max) {
+    rl.rlim_cur = rl.rlim_max;
+    (void)setrlimit(RLIMIT_MEMLOCK, &rl);
+    (void)getrlimit(RLIMIT_MEMLOCK, &rl);
+  }
+  return rl.rlim_cur == RLIM_INFINITY ? SIZE_MAX
+                                      : static_cast<size_t>(rl.rlim_cur);
+}
+
+// Largest PROT_NONE mapping taken for a thread stack's guard (glibc uses
+// one page unless pthread_attr_setguardsize asks for more)
+constexpr uintptr_t kMaxStackGuard = 1 << 20;
+} // namespace
+
+std::vector<MemoryRegion> parseMaps(const std::string &text) {
+  std::vector<MemoryRegion> regions;
+  std::istringstream lines(text);
+  std::string line;
+  MemoryRegion guard; // Last anonymous PROT_NONE mapping
+  while (std::getline(lines, line)) {
+    std::istringstream fields(line);
+    std::string range, perms, offset, dev, inode, path;
+    if (!(fields >> range >> perms >> offset >> dev >> inode))
+      continue;
+    fields >> path;
+    auto dash = range.find('-');
+    if (dash == std::string::npos || perms.size() < 4)
+      continue;
+    MemoryRegion r;
+    r.start = std::stoull(range.substr(0, dash), nullptr, 16);
+    r.end = std::stoull(range.substr(dash + 1), nullptr, 16);
+    const MemoryRegion below = guard;
+    guard = {};
+    if (perms.compare(0, 3, "---") == 0 && path.empty()) {
+      guard = r;
+      continue;
+    }
+    if (perms[0] != 'r' || perms[1] != 'w' || perms[3] != 'p')
+      continue;
+    if (!path.empty() && path != "[heap]")
+      continue; // Files, devices, [stack], [vvar]
+    // Guard page right below: a thread stack, not data worth pinning
+    if (path.empty() && below.end == r.start && below.size() > 0 &&
+        below.size() <= kMaxStackGuard)
+      continue;
+    if (r.end > r.start)
+      regions.push_back(r);
+  }
+  return regions;
+}
+
+std::vector<MemoryRegion> readMaps(const std::string &path) {
+  std::ifstream f(path);
+  std::stringstream ss;
+  ss << f.rdbuf();
+  return parseMaps(ss.str());
+}
+
+std::vector<MemoryRegion> grownRegions(const std::vector<MemoryRegion> &before,
+                                       const std::vector<MemoryRegion> &after) {
+  std::vector<MemoryRegion> old = before;
+  std::sort(old.begin(), old.end(),
+            [](const MemoryRegion &a, const MemoryRegion &b) {
+              return a.start < b.start;
+            });
+  std::vector<MemoryRegion> grown;
+  for (const auto &r : after) {
+    uintptr_t pos = r.start;
+    for (const auto &o : old) {
+      if (o.end <= pos || o.start >= r.end)
+        continue;
+      if (o.start > pos)
+        grown.push_back({pos, o.start});
+      pos = std::max(pos, o.end);
+      if (pos >= r.end)
+        break;
+    }
+    if (pos < r.end)
+      grown.push_back({pos, r.end});
+  }
+  return grown;
+}
+
+size_t MemoryLocker::lock(const void *addr, size_t len) {
+  if (!addr || len == 0)
+    return 0;
+  // mlock works on whole pages
+  const size_t page = pageSize();
+  uintptr_t start = reinterpret_cast<uintptr_t>(addr) & ~(page - 1);
+  size_t span = (reinterpret_cast<uintptr_t>(addr) + len - start + page - 1) &
+                ~(page - 1);
+
+  if (cap_ > 0 && locked_ + span > cap_) {
+    limited_ = true;
+    error_ = 0;
+    if (locked_ >= cap_)
+      return 0;
+    span = (cap_ - locked_) & ~(page - 1);
+  }
+  if (span > 0 && mlock(reinterpret_cast<void *>(start), span) != 0) {
+    // Over RLIMIT_MEMLOCK: retry once with what the (raised) limit allows
+    limited_ = true;
+    error_ = errno;
+    size_t limit = raiseMemlockLimit();
+    size_t fits = limit > locked_ ? (limit - locked_) & ~(page - 1) : 0;
+    if (fits == 0)
+      return 0;
+    if (mlock(reinterpret_cast<void *>(start), std::min(fits, span)) != 0) {
+      error_ = errno;
+      return 0;
+    }
+    span = std::min(fits, span);
+  }
+  if (span == 0)
+    return 0;
+  ranges_.emplace_back(start, span);
+  locked_ += span;
+  return span;
+}
+
+size_t MemoryLocker::lock(const std::vector<MemoryRegion> &regions) {
+  limited_ = false;
+  error_ = 0;
+  size_t total = 0;
+  for (const auto &r : regions) {
+    total += lock(reinterpret_cast<const void *>(r.start), r.size());
+    if (limited_)
+      break;
+  }
+  return total;
+}
+
+void MemoryLocker::unlockAll() {
+  // Ranges that were unmapped meanwhile fail with ENOMEM; nothing to undo
+  for (const auto &[start, len] : ranges_)
+    (void)munlock(reinterpret_cast<void *>(start), len);
+  ranges_.clear();
+  locked_ = 0;
+  limited_ = false;
+  error_ = 0;
+}
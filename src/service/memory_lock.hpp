@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Pinning of hot memory (lock_memory). OpenCV does not expose where a
+// network keeps its weights, so the engine compares /proc/self/maps before
+// and after loading and locks the private anonymous memory that appeared
+// in between: the graphs, weights and warm-up blobs.
+
+struct MemoryRegion {
+  uintptr_t start = 0;
+  uintptr_t end = 0;
+  size_t size() const { return end - start; }
+};
+
+// Writable private anonymous mappings (including [heap]) of a maps file.
+// Thread stacks are left out: glibc maps them with a small PROT_NONE guard
+// right below, and the pthread stack cache keeps them after the thread ends.
+std::vector<MemoryRegion> parseMaps(const std::string &text);
+std::vector<MemoryRegion> readMaps(const std::string &path = "/proc/self/maps");
+
+// Address ranges of `after` not covered by any region of `before`
+std::vector<MemoryRegion> grownRegions(const std::vector<MemoryRegion> &before,
+                                       const std::vector<MemoryRegion> &after);
+
+// mlock() within a byte cap. Locking faults every page in, so the regions
+// are also prefaulted. When RLIMIT_MEMLOCK is too low (unprivileged runs)
+// the soft limit is raised to the hard one, then as much as fits is locked.
+class MemoryLocker {
+public:
+  explicit MemoryLocker(size_t cap_bytes = 0) : cap_(cap_bytes) {}
+  ~MemoryLocker() { unlockAll(); }
+  MemoryLocker(const MemoryLocker &) = delete;
+  MemoryLocker &operator=(const MemoryLocker &) = delete;
+
+  void setCap(size_t cap_bytes) { cap_ = cap_bytes; }
+  // Bytes locked by this call
+  size_t lock(const void *addr, size_t len);
+  size_t lock(const std::vector<MemoryRegion> &regions);
+  // Must run before the memory is freed
+  void unlockAll();
+
+  size_t locked() const { return locked_; }
+  // The cap or RLIMIT_MEMLOCK stopped the last lock() short
+  bool limited() const { return limited_; }
+  // errno of the mlock() that stopped it, 0 if the cap did
+  int error() const { return error_; }
+
+private:
+  size_t cap_;
+  size_t locked_ = 0;
+  bool limited_ = false;
+  int error_ = 0;
+  std::vector<std::pair<uintptr_t, size_t>> ranges_;
+};
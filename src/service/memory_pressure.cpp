@@ -0,0 +1,157 @@
+#include "memory_pressure.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+#include <utility>
+
+namespace {
+std::string readText(const std::string &path) {
+  std::ifstream f(path);
+  if (!f.is_open())
+    return "";
+  std::stringstream ss;
+  ss << f.rdbuf();
+  return ss.str();
+}
+} // namespace
+
+bool parsePsi(const std::string &text, PsiSample &out) {
+  out = PsiSample();
+  bool have_some = false;
+  std::istringstream lines(text);
+  std::string line;
+  while (std::getline(lines, line)) {
+    std::istringstream fields(line);
+    std::string kind, field;
+    fields >> kind;
+    PsiLine *dst = nullptr;
+    if (kind == "some")
+      dst = &out.some;
+    else if (kind == "full")
+      dst = &out.full;
+    else
+      continue;
+    while (fields >> field) {
+      auto eq = field.find('=');
+      if (eq == std::string::npos)
+        continue;
+      const std::string key = field.substr(0, eq);
+      const std::string value = field.substr(eq + 1);
+      try {
+        if (key == "avg10")
+          dst->avg10 = std::stod(value);
+        else if (key == "avg60")
+          dst->avg60 = std::stod(value);
+        else if (key == "avg300")
+          dst->avg300 = std::stod(value);
+        else if (key == "total")
+          dst->total = std::stoull(value);
+      } catch (...) {
+        return false;
+      }
+    }
+    if (dst == &out.some)
+      have_some = true;
+  }
+  return have_some;
+}
+
+bool readPsi(const std::string &path, PsiSample &out) {
+  return parsePsi(readText(path), out);
+}
+
+bool readMemoryEvents(const std::string &path, MemoryEvents &out) {
+  std::ifstream f(path);
+  if (!f.is_open())
+    return false;
+  out = MemoryEvents();
+  std::string key;
+  uint64_t value = 0;
+  while (f >> key >> value) {
+    if (key == "low")
+      out.low = value;
+    else if (key == "high")
+      out.high = value;
+    else if (key == "max")
+      out.max = value;
+    else if (key == "oom")
+      out.oom = value;
+    else if (key == "oom_kill")
+      out.oom_kill = value;
+  }
+  return true;
+}
+
+std::string cgroupMemoryEventsPath(const std::string &proc_cgroup,
+                                   const std::string &cgroup_root) {
+  std::ifstream f(proc_cgroup);
+  std::string line;
+  while (std::getline(f, line)) {
+    if (line.rfind("0::", 0) != 0)
+      continue;
+    std::string path = cgroup_root + line.substr(3) + "/memory.events";
+    if (access(path.c_str(), R_OK) == 0)
+      return path;
+  }
+  return "";
+}
+
+const char *pressureLevelName(PressureLevel level) {
+  switch (level) {
+  case PressureLevel::NONE:
+    return "none";
+  case PressureLevel::LOW:
+    return "low";
+  case PressureLevel::MEDIUM:
+    return "medium";
+  case PressureLevel::CRITICAL:
+    return "critical";
+  }
+  return "unknown";
+}
+
+MemoryPressureMonitor::MemoryPressureMonitor(std::string psi_path,
+                                             std::string events_path,
+                                             double some_avg10,
+                                             double full_avg10)
+    : psi_path_(std::move(psi_path)), events_path_(std::move(events_path)),
+      some_avg10_(some_avg10), full_avg10_(full_avg10) {
+  if (!events_path_.empty())
+    have_events_ = readMemoryEvents(events_path_, events_);
+}
+
+bool MemoryPressureMonitor::available() const {
+  PsiSample sample;
+  return readPsi(psi_path_, sample);
+}
+
+PressureLevel MemoryPressureMonitor::poll() {
+  PressureLevel level = PressureLevel::NONE;
+  auto raise = [&level](PressureLevel l) {
+    if (l > level)
+      level = l;
+  };
+
+  if (readPsi(psi_path_, last_)) {
+    if (last_.some.avg10 >= some_avg10_)
+      raise(PressureLevel::LOW);
+    if (last_.full.avg10 >= full_avg10_)
+      raise(PressureLevel::MEDIUM);
+    if (last_.full.avg10 >= 2.0 * full_avg10_)
+      raise(PressureLevel::CRITICAL);
+  }
+
+  MemoryEvents now;
+  if (!events_path_.empty() && readMemoryEvents(events_path_, now)) {
+    if (have_events_) {
+      if (now.high > events_.high)
+        raise(PressureLevel::MEDIUM);
+      if (now.max > events_.max || now.oom > events_.oom)
+        raise(PressureLevel::CRITICAL);
+    }
+    events_ = now;
+    have_events_ = true;
+  }
+  return level;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Memory pressure from the kernel's PSI interface (/proc/pressure/memory,
+// or memory.pressure of a cgroup v2 group) and the cgroup's memory.events
+// counters. Lets the daemon keep its models loaded while the system has
+// headroom and shed them in stages once reclaim starts stalling tasks.
+
+struct PsiLine {
+  double avg10 = 0.0; // % of wall time stalled, 10 s window
+  double avg60 = 0.0;
+  double avg300 = 0.0;
+  uint64_t total = 0; // Cumulative stall time in us
+};
+
+struct PsiSample {
+  PsiLine some; // At least one task stalled on memory
+  PsiLine full; // All non-idle tasks stalled at once
+};
+
+// Parse the contents of a PSI file ("some avg10=... total=...\nfull ...").
+// Kernels before 5.13 omit "full" for the system file; it stays zero.
+bool parsePsi(const std::string &text, PsiSample &out);
+bool readPsi(const std::string &path, PsiSample &out);
+
+// cgroup v2 memory.events (cumulative counters)
+struct MemoryEvents {
+  uint64_t low = 0;
+  uint64_t high = 0; // Throttled for exceeding memory.high
+  uint64_t max = 0;  // Hit memory.max, reclaim forced
+  uint64_t oom = 0;
+  uint64_t oom_kill = 0;
+};
+
+bool readMemoryEvents(const std::string &path, MemoryEvents &out);
+
+// memory.events of the cgroup listed in `proc_cgroup` (the "0::" v2 entry),
+// empty on cgroup v1 or if the file does not exist
+std::string cgroupMemoryEventsPath(
+    const std::string &proc_cgroup = "/proc/self/cgroup",
+    const std::string &cgroup_root = "/sys/fs/cgroup");
+
+// Ordered so that each level also implies everything below it
+enum class PressureLevel {
+  NONE = 0,
+  LOW = 1,      // Some tasks stall: drop the recognizers
+  MEDIUM = 2,   // Everything stalls: drop the detector too
+  CRITICAL = 3, // Sustained full stalls or cgroup limit hit: drop all
+};
+
+const char *pressureLevelName(PressureLevel level);
+
+class MemoryPressureMonitor {
+public:
+  // Thresholds are PSI avg10 percentages. CRITICAL is twice full_avg10, or
+  // any new memory.max / oom event in our cgroup.
+  MemoryPressureMonitor(std::string psi_path, std::string events_path,
+                        double some_avg10 = 10.0, double full_avg10 = 5.0);
+
+  // False if the PSI file can't be read (kernel without CONFIG_PSI)
+  bool available() const;
+  // Sample both sources and classify the current pressure. Event counters
+  // are compared with the previous poll, so a limit hit counts once.
+  PressureLevel poll();
+
+  const PsiSample &last() const { return last_; }
+
+private:
+  std::string psi_path_;
+  std::string events_path_;
+  double some_avg10_;
+  double full_avg10_;
+  PsiSample last_;
+  MemoryEvents events_;
+  bool have_events_ = false;
+};
@@ -0,0 +1,77 @@
+#include "memory_usage.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+bool parseProcStatus(const std::string &text, ProcessMemory &out) {
+  out = ProcessMemory();
+  bool have_rss = false;
+  std::istringstream lines(text);
+  std::string line;
+  while (std::getline(lines, line)) {
+    std::istringstream fields(line);
+    std::string key;
+    size_t kb = 0;
+    if (!(fields >> key >> kb))
+      continue;
+    if (key == "VmRSS:") {
+      out.rss = kb * 1024;
+      have_rss = true;
+    } else if (key == "RssAnon:") {
+      out.rss_anon = kb * 1024;
+    } else if (key == "RssFile:") {
+      out.rss_file = kb * 1024;
+    } else if (key == "VmLck:") {
+      out.locked = kb * 1024;
+    }
+  }
+  return have_rss;
+}
+
+bool readProcessMemory(ProcessMemory &out, const std::string &path) {
+  std::ifstream f(path);
+  if (!f.is_open())
+    return false;
+  std::stringstream ss;
+  ss << f.rdbuf();
+  return parseProcStatus(ss.str(), out);
+}
+
+HeapStats heapStats() {
+  HeapStats stats;
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+  struct mallinfo2 mi = mallinfo2();
+  stats.valid = true;
+  stats.in_use = mi.uordblks + mi.hblkhd;
+  stats.free = mi.fordblks;
+#endif
+  return stats;
+}
+
+size_t trimHeap() {
+#ifdef __GLIBC__
+  ProcessMemory before, after;
+  if (!readProcessMemory(before)) {
+    malloc_trim(0);
+    return 0;
+  }
+  malloc_trim(0);
+  if (!readProcessMemory(after) || after.rss >= before.rss)
+    return 0;
+  return before.rss - after.rss;
+#else
+  return 0;
+#endif
+}
+
+std::string formatBytes(size_t bytes) {
+  char buf[32];
+  std::snprintf(buf, sizeof(buf), "%.1f MiB",
+                static_cast<double>(bytes) / (1024.0 * 1024.0));
+  return buf;
+}
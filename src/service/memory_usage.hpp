@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// Process memory as the kernel and glibc see it, and explicit reclamation.
+// Freed DNN buffers normally stay in the malloc heap (the mmap threshold
+// grows past them after the first large free), so unloading models barely
+// changes RSS unless the heap is trimmed.
+
+struct ProcessMemory {
+  size_t rss = 0;      // Bytes, VmRSS
+  size_t rss_anon = 0; // Heap, stacks, model graphs
+  size_t rss_file = 0; // Mapped libraries and files
+  size_t locked = 0;   // VmLck
+};
+
+// Parse /proc/<pid>/status contents (kB values)
+bool parseProcStatus(const std::string &text, ProcessMemory &out);
+bool readProcessMemory(ProcessMemory &out,
+                       const std::string &path = "/proc/self/status");
+
+struct HeapStats {
+  bool valid = false; // False without glibc >= 2.33 (mallinfo2)
+  size_t in_use = 0;  // Allocated chunks
+  size_t free = 0;    // Held by malloc but unused
+};
+
+HeapStats heapStats();
+
+// Return free heap pages to the kernel, including those in the middle of an
+// arena. Bytes of RSS released (0 outside glibc or if nothing was trimmed).
+size_t trimHeap();
+
+// "12.3 MiB"
+std::string formatBytes(size_t bytes);
@@ -0,0 +1,202 @@
+#include "model_registry.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <opencv2/core/version.hpp>
+#include <opencv2/dnn.hpp>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace {
+bool endsWith(const std::string &s, const std::string &suffix) {
+  return s.size() >= suffix.size() &&
+         s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+cv::Size parseSize(const std::string &text, cv::Size def) {
+  int w = 0, h = 0;
+  char sep = 0;
+  std::istringstream in(text);
+  if (in >> w >> sep >> h && (sep == 'x' || sep == 'X') && w > 0 && h > 0)
+    return cv::Size(w, h);
+  return def;
+}
+
+ModelSpec readSpec(const ModelRegistry::Getter &get, const std::string &key,
+                   const std::string &models_dir, const std::string &def_path,
+                   cv::Size def_input, int def_dim) {
+  ModelSpec spec;
+  spec.path = get("Models." + key, def_path);
+  if (spec.path.empty())
+    return spec;
+  if (fs::path(spec.path).is_relative())
+    spec.path = models_dir + "/" + spec.path;
+  spec.precision =
+      parseModelPrecision(get("Models." + key + "_precision", "auto"),
+                          spec.path);
+  spec.input_size =
+      parseSize(get("Models." + key + "_input_size", ""), def_input);
+  spec.embedding_dim =
+      std::stoi(get("Models." + key + "_dim", std::to_string(def_dim)));
+  return spec;
+}
+} // namespace
+
+ModelPrecision parseModelPrecision(const std::string &name,
+                                   const std::string &path) {
+  if (name == "fp32")
+    return ModelPrecision::FP32;
+  if (name == "int8")
+    return ModelPrecision::INT8;
+  if (name == "int8bq")
+    return ModelPrecision::INT8_BLOCK;
+
+  std::string stem = fs::path(path).stem().string();
+  if (endsWith(stem, "_int8bq"))
+    return ModelPrecision::INT8_BLOCK;
+  if (endsWith(stem, "_int8"))
+    return ModelPrecision::INT8;
+  return ModelPrecision::FP32;
+}
+
+std::string precisionName(ModelPrecision precision) {
+  switch (precision) {
+  case ModelPrecision::INT8:
+    return "int8";
+  case ModelPrecision::INT8_BLOCK:
+    return "int8bq";
+  default:
+    return "fp32";
+  }
+}
+
+std::string getModelVersion(const std::string &model_path) {
+  fs::path p(model_path);
+  std::string filename = p.stem().string();
+  const std::string prefix = "face_recognition_";
+  if (filename.rfind(prefix, 0) == 0) {
+    return filename.substr(prefix.length());
+  }
+  return filename;
+}
+
+std::vector<std::vector<float>>
+loadVariantEmbeddings(const nlohmann::json &j, const std::string &type,
+                      const std::string &version, int dim) {
+  std::vector<std::vector<float>> variants;
+  std::string emb_array_key = "embeddings_" + type;
+  if (!j.contains(emb_array_key) || !j[emb_array_key].is_array())
+    return variants;
+  for (const auto &entry : j[emb_array_key]) {
+    if (!entry.contains("variants") || !entry["variants"].contains(version))
+      return {};
+    variants.push_back(entry["variants"][version].get<std::vector<float>>());
+    if (dim > 0 && static_cast<int>(variants.back().size()) != dim)
+      return {};
+  }
+  return variants;
+}
+
+std::string ModelSpec::version() const {
+  std::string v = getModelVersion(path);
+  if (precision == ModelPrecision::FP32)
+    return v;
+  std::string tag = "_" + precisionName(precision);
+  return endsWith(v, tag) ? v : v + tag;
+}
+
+void ModelSpec::selectBackend(int &backend_id, int &target_id) const {
+  if (precision == ModelPrecision::FP32)
+    return;
+  if (target_id == cv::dnn::DNN_TARGET_OPENCL ||
+      target_id == cv::dnn::DNN_TARGET_OPENCL_FP16) {
+    backend_id = cv::dnn::DNN_BACKEND_OPENCV;
+    target_id = cv::dnn::DNN_TARGET_CPU;
+  }
+}
+
+bool ModelSpec::supported(std::string &reason) const {
+  if (!fs::exists(path)) {
+    reason = path + " not found";
+    return false;
+  }
+#if CV_VERSION_MAJOR == 4 && CV_VERSION_MINOR < 10
+  if (precision == ModelPrecision::INT8_BLOCK) {
+    reason = "block-quantized models need OpenCV 4.10 or newer (have " +
+             std::string(CV_VERSION) + ")";
+    return false;
+  }
+#endif
+  return true;
+}
+
+ModelRegistry ModelRegistry::fromConfig(const Getter &get,
+                                        const std::string &models_dir) {
+  ModelRegistry r;
+  r.detection =
+      readSpec(get, "face_detection", models_dir,
+               "face_detection_yunet_2022mar.onnx", cv::Size(640, 480), 0);
+  r.recognition =
+      readSpec(get, "face_recognition", models_dir,
+               "face_recognition_sface_2021dec.onnx", cv::Size(112, 112), 128);
+  r.recognition_fast = readSpec(get, "face_recognition_fast", models_dir, "",
+                                cv::Size(112, 112), 128);
+  return r;
+}
+
+namespace {
+bool readFile(const std::string &path, std::vector<uchar> &out) {
+  out.clear();
+  if (path.empty())
+    return true;
+  std::ifstream f(path, std::ios::binary);
+  if (!f.is_open())
+    return false;
+  out.assign(std::istreambuf_iterator<char>(f),
+             std::istreambuf_iterator<char>());
+  return !out.empty();
+}
+} // namespace
+
+size_t ModelBuffers::bytes() const {
+  return detection.size() + recognition.size() + recognition_fast.size();
+}
+
+void ModelBuffers::clear() {
+  // shrink_to_fit: clear() alone keeps the capacity allocated
+  for (auto *b : {&detection, &recognition, &recognition_fast}) {
+    b->clear();
+    b->shrink_to_fit();
+  }
+}
+
+bool ModelBuffers::read(const ModelRegistry &models) {
+  if (readFile(models.detection.path, detection) &&
+      readFile(models.recognition.path, recognition) &&
+      readFile(models.recognition_fast.path, recognition_fast))
+    return true;
+  clear();
+  return false;
+}
+
+cv::dnn::Net readModelNet(const std::string &path,
+                          const std::vector<uchar> &bytes) {
+  if (bytes.empty())
+    return cv::dnn::readNet(path);
+  return cv::dnn::readNetFromONNX(bytes);
+}
+
+cv::Ptr<cv::FaceRecognizerSF> createRecognizer(const std::string &path,
+                                               const std::vector<uchar> &bytes,
+                                               int backend_id, int target_id) {
+#if CV_VERSION_MAJOR > 4 || (CV_VERSION_MAJOR == 4 && CV_VERSION_MINOR >= 11)
+  if (!bytes.empty())
+    return cv::FaceRecognizerSF::create("onnx", bytes, {}, backend_id,
+                                        target_id);
+#else
+  (void)bytes;
+#endif
+  return cv::FaceRecognizerSF::create(path, "", backend_id, target_id);
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "json.hpp"
+
+#include <functional>
+#include <opencv2/core.hpp>
+#include <opencv2/dnn.hpp>
+#include <opencv2/objdetect.hpp>
+#include <string>
+#include <vector>
+
+// Weight format of an ONNX model from the OpenCV zoo
+enum class ModelPrecision {
+  FP32,
+  INT8,      // Per-tensor quantized (*_int8.onnx)
+  INT8_BLOCK // Block-wise quantized (*_int8bq.onnx), OpenCV >= 4.10
+};
+
+// "fp32" | "int8" | "int8bq"; "auto" (or empty) guesses from the file name
+ModelPrecision parseModelPrecision(const std::string &name,
+                                   const std::string &path);
+std::string precisionName(ModelPrecision precision);
+
+// Version tag from a model file name (e.g. sface_2021dec_int8)
+std::string getModelVersion(const std::string &model_path);
+
+// Embeddings of a cascade stage (entry["variants"][version]) for one camera
+// type. Empty unless every entry has one of size `dim` (0 = any), so the
+// fast stage never misses an enrolled look.
+std::vector<std::vector<float>>
+loadVariantEmbeddings(const nlohmann::json &j, const std::string &type,
+                      const std::string &version, int dim);
+
+struct ModelSpec {
+  std::string path;
+  ModelPrecision precision = ModelPrecision::FP32;
+  cv::Size input_size;   // Network input (recognizers: aligned crop size)
+  int embedding_dim = 0; // Recognizers only; 0 = take whatever it outputs
+
+  // Stored as model_version with every embedding. Includes the precision
+  // when the file name doesn't already say it.
+  std::string version() const;
+  // Quantized layers only run on the CPU target: OpenCL targets are mapped
+  // to the plain OpenCV CPU backend for int8 models.
+  void selectBackend(int &backend_id, int &target_id) const;
+  // False (with a reason) if this OpenCV build can't run the model
+  bool supported(std::string &reason) const;
+};
+
+// Models used by the daemon, from the [Models] section:
+//   <key> = path (absolute, or relative to models_dir)
+//   <key>_precision = auto | fp32 | int8 | int8bq
+//   <key>_input_size = WxH
+//   <key>_dim = embedding size (recognizers)
+// with key face_detection, face_recognition or face_recognition_fast.
+struct ModelRegistry {
+  ModelSpec detection;
+  ModelSpec recognition;
+  ModelSpec recognition_fast; // Empty path = no recognizer cascade
+
+  using Getter =
+      std::function<std::string(const std::string &, const std::string &)>;
+  static ModelRegistry fromConfig(const Getter &get,
+                                  const std::string &models_dir);
+};
+
+// Raw ONNX bytes of the registry's models, kept while the networks are
+// unloaded (unload_tier = buffers) so a wake-up rebuilds them from memory:
+// graph construction only, no disk I/O.
+struct ModelBuffers {
+  std::vector<uchar> detection;
+  std::vector<uchar> recognition;
+  std::vector<uchar> recognition_fast;
+
+  bool empty() const { return detection.empty() && recognition.empty(); }
+  size_t bytes() const;
+  void clear();
+  // Read every model file; false (and cleared) if one can't be read
+  bool read(const ModelRegistry &models);
+};
+
+// Network from in-memory ONNX bytes, or from `path` if there are none
+cv::dnn::Net readModelNet(const std::string &path,
+                          const std::vector<uchar> &bytes);
+// Same for FaceRecognizerSF. Before OpenCV 4.11 it can only load files, so
+// `bytes` is ignored there.
+cv::Ptr<cv::FaceRecognizerSF> createRecognizer(const std::string &path,
+                                               const std::vector<uchar> &bytes,
+                                               int backend_id, int target_id);
@@ -0,0 +1,49 @@
+#include "parallel_backend.hpp"
+
+#include <opencv2/core.hpp>
+#include <opencv2/core/version.hpp>
+
+#if CV_VERSION_MAJOR > 4 || (CV_VERSION_MAJOR == 4 && CV_VERSION_MINOR >= 6)
+#define LINUXCAMPAM_HAVE_PARALLEL_API 1
+#include <opencv2/core/parallel/parallel_backend.hpp>
+#endif
+
+#ifdef LINUXCAMPAM_HAVE_PARALLEL_API
+namespace {
+class PoolBackend : public cv::parallel::ParallelForAPI {
+public:
+  explicit PoolBackend(std::shared_ptr<ThreadPool> pool)
+      : pool_(std::move(pool)) {}
+
+  int getThreadNum() const override { return ThreadPool::workerIndex(); }
+  int getNumThreads() const override { return pool_->concurrency(); }
+  int setNumThreads(int threads) override {
+    int previous = pool_->concurrency();
+    pool_->setConcurrency(threads);
+    return previous;
+  }
+  void parallel_for(int tasks, FN_parallel_for_body_cb_t body,
+                    void *data) override {
+    pool_->parallelFor(tasks,
+                       [body, data](int begin, int end) {
+                         body(begin, end, data);
+                       });
+  }
+  const char *getName() const override { return "linuxcampam"; }
+
+private:
+  std::shared_ptr<ThreadPool> pool_;
+};
+} // namespace
+#endif
+
+bool installParallelBackend(const std::shared_ptr<ThreadPool> &pool) {
+#ifdef LINUXCAMPAM_HAVE_PARALLEL_API
+  cv::parallel::setParallelForBackend(std::make_shared<PoolBackend>(pool),
+                                      false);
+  return true;
+#else
+  (void)pool;
+  return false;
+#endif
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "thread_pool.hpp"
+
+#include <memory>
+
+// Register `pool` as OpenCV's parallel_for backend (OpenCV >= 4.6).
+// cv::setNumThreads() then caps the threads a parallel region may use
+// (see ThreadPool::setConcurrency) instead of resizing a pool. Returns false
+// if this OpenCV build can't switch backends.
+bool installParallelBackend(const std::shared_ptr<ThreadPool> &pool);
@@ -0,0 +1,52 @@
+#include "score_fusion.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+double ScoreModel::llr(float score) const {
+  score = std::clamp(score, impostor_mean,
+                     std::max(impostor_mean, genuine_mean));
+  auto log_pdf = [score](float mean, float sd) {
+    double z = (score - mean) / sd;
+    return -0.5 * z * z - std::log(static_cast<double>(sd));
+  };
+  return log_pdf(genuine_mean, genuine_std) -
+         log_pdf(impostor_mean, impostor_std);
+}
+
+bool ScoreModel::valid() const {
+  if (!(genuine_std > 0.0f && impostor_std > 0.0f &&
+        genuine_mean > impostor_mean))
+    return false;
+  double prev = llr(-1.0f);
+  for (int i = 1; i <= 200; i++) {
+    double cur = llr(-1.0f + i * 0.01f);
+    if (!std::isfinite(cur) || cur < prev)
+      return false;
+    prev = cur;
+  }
+  return prev > llr(-1.0f);
+}
+
+SequentialTest::SequentialTest(const ScoreModel &model,
+                               double false_accept_rate,
+                               double false_reject_rate, double max_frame_llr)
+    : model_(model) {
+  // Wald's bounds: A = (1 - beta) / alpha, B = beta / (1 - alpha)
+  accept_bound_ = std::log((1.0 - false_reject_rate) / false_accept_rate);
+  reject_bound_ = std::log(false_reject_rate / (1.0 - false_accept_rate));
+  max_frame_llr_ = std::min(max_frame_llr, kMaxFrameShare * accept_bound_);
+}
+
+FusionDecision SequentialTest::add(float score) {
+  if (decision_ != FusionDecision::CONTINUE)
+    return decision_;
+
+  llr_ += std::clamp(model_.llr(score), -max_frame_llr_, max_frame_llr_);
+  samples_++;
+  if (llr_ >= accept_bound_)
+    decision_ = FusionDecision::ACCEPT;
+  else if (llr_ <= reject_bound_)
+    decision_ = FusionDecision::REJECT;
+  return decision_;
+}
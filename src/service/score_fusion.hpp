@@ -0,0 +1,64 @@
+#pragma once
+
+#include <limits>
+
+// Gaussian fit of a recognizer's cosine scores for genuine (same person) and
+// impostor comparisons. Defaults roughly match SFace on enrolled IR/RGB
+// faces; recalibrate from `linuxcampam test` output for other models.
+struct ScoreModel {
+  float genuine_mean = 0.60f;
+  float genuine_std = 0.12f;
+  float impostor_mean = 0.05f;
+  float impostor_std = 0.10f;
+
+  // log p(score | genuine) - log p(score | impostor), with the score clamped
+  // to [impostor_mean, genuine_mean]. Outside that range the unequal-variance
+  // ratio turns around (a very low score can look genuine when genuine_std >
+  // impostor_std), so the tails count no more than the means themselves.
+  double llr(float score) const;
+
+  // Positive spreads, genuine_mean > impostor_mean and an LLR that never
+  // decreases over the cosine range [-1, 1]
+  bool valid() const;
+};
+
+enum class FusionDecision { CONTINUE, ACCEPT, REJECT };
+
+// Wald's sequential probability ratio test over per-frame scores.
+// Evidence from successive frames (and cameras, when pooled) is summed until
+// it crosses the accept or reject bound derived from the target error rates:
+// clear matches decide on two frames (the first IR and RGB frame when
+// pooled), borderline ones keep sampling. Each frame's contribution is
+// clipped to `max_frame_llr` and never above kMaxFrameShare of the accept
+// bound, so no single frame can accept on its own.
+// Callers should only add re-recognized frames since repeated scores of the
+// same crop are not independent evidence.
+class SequentialTest {
+public:
+  SequentialTest() : SequentialTest(ScoreModel(), 1e-4, 1e-3) {}
+  SequentialTest(const ScoreModel &model, double false_accept_rate,
+                 double false_reject_rate,
+                 double max_frame_llr =
+                     std::numeric_limits<double>::infinity());
+
+  FusionDecision add(float score);
+  FusionDecision decision() const { return decision_; }
+
+  double evidence() const { return llr_; }
+  int samples() const { return samples_; }
+  double acceptBound() const { return accept_bound_; }
+  double rejectBound() const { return reject_bound_; }
+  double maxFrameLLR() const { return max_frame_llr_; }
+
+  // Largest share of the accept bound a single frame may contribute
+  static constexpr double kMaxFrameShare = 0.6;
+
+private:
+  ScoreModel model_;
+  double accept_bound_;
+  double reject_bound_;
+  double max_frame_llr_;
+  double llr_ = 0.0;
+  int samples_ = 0;
+  FusionDecision decision_ = FusionDecision::CONTINUE;
+};
@@ -0,0 +1,200 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <sched.h>
+
+namespace {
+thread_local int t_worker = 0; // 1-based index, 0 = not a pool thread
+thread_local ThreadPool::Priority t_priority = ThreadPool::Priority::NORMAL;
+// Pool that owns the calling worker (nested submits go to its deque)
+thread_local const void *t_pool = nullptr;
+
+size_t affinityCpus() {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) == 0)
+    return static_cast<size_t>(CPU_COUNT(&set));
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Shared state of one parallelFor, kept alive by every helper task
+struct ForJob {
+  std::function<void(int, int)> body;
+  int chunks = 0;
+  int chunk_size = 1;
+  int n = 0;
+  std::atomic<int> next{0};
+  std::atomic<int> done{0};
+  std::mutex mutex;
+  std::condition_variable finished;
+  std::exception_ptr error;
+
+  // Claim and run chunks until none are left
+  void work() {
+    for (int c; (c = next.fetch_add(1)) < chunks;) {
+      int begin = c * chunk_size;
+      int end = std::min(n, begin + chunk_size);
+      try {
+        body(begin, end);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error)
+          error = std::current_exception();
+      }
+      if (done.fetch_add(1) + 1 == chunks) {
+        std::lock_guard<std::mutex> lock(mutex);
+        finished.notify_all();
+      }
+    }
+  }
+};
+} // namespace
+
+ThreadPool::PriorityScope::PriorityScope(Priority p) : saved_(t_priority) {
+  t_priority = p;
+}
+
+ThreadPool::PriorityScope::~PriorityScope() { t_priority = saved_; }
+
+ThreadPool::ThreadPool(size_t workers) {
+  if (workers == 0)
+    workers = std::max<size_t>(1, affinityCpus() - 1);
+  for (size_t i = 0; i < workers; i++)
+    workers_.push_back(std::make_unique<Worker>());
+  for (size_t i = 0; i < workers; i++)
+    workers_[i]->thread = std::thread([this, i] { workerLoop(i); });
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  for (auto &w : workers_) {
+    if (w->thread.joinable())
+      w->thread.join();
+  }
+}
+
+int ThreadPool::workerIndex() { return t_worker; }
+
+int ThreadPool::setConcurrency(int threads) {
+  return concurrency_.exchange(std::max(0, threads));
+}
+
+int ThreadPool::concurrency() const {
+  int c = concurrency_.load();
+  int all = static_cast<int>(workers_.size()) + 1;
+  return c > 0 ? std::min(c, all) : all;
+}
+
+void ThreadPool::push(Task task) {
+  // Counted first: a worker may take the task before this returns
+  pending_++;
+  if (t_pool == this && t_worker > 0) {
+    Worker &w = *workers_[t_worker - 1];
+    std::lock_guard<std::mutex> lock(w.mutex);
+    w.local.push_back(std::move(task));
+  } else {
+    std::lock_guard<std::mutex> lock(mutex_);
+    injected_[static_cast<int>(task.priority)].push_back(std::move(task));
+  }
+  // Under mutex_ so a worker can't miss it between checking and sleeping
+  std::lock_guard<std::mutex> lock(mutex_);
+  wake_.notify_one();
+}
+
+std::future<void> ThreadPool::submit(std::function<void()> task) {
+  auto packaged =
+      std::make_shared<std::packaged_task<void()>>(std::move(task));
+  std::future<void> result = packaged->get_future();
+  push({[packaged] { (*packaged)(); }, t_priority});
+  return result;
+}
+
+bool ThreadPool::takeTask(size_t index, Task &task) {
+  auto popInjected = [this, &task](Priority p) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &q = injected_[static_cast<int>(p)];
+    if (q.empty())
+      return false;
+    task = std::move(q.front());
+    q.pop_front();
+    return true;
+  };
+
+  if (popInjected(Priority::HIGH))
+    return true;
+  {
+    Worker &own = *workers_[index];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.local.empty()) {
+      task = std::move(own.local.back());
+      own.local.pop_back();
+      return true;
+    }
+  }
+  if (popInjected(Priority::NORMAL))
+    return true;
+  for (size_t k = 1; k < workers_.size(); k++) {
+    Worker &victim = *workers_[(index + k) % workers_.size()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.local.empty()) {
+      task = std::move(victim.local.front());
+      victim.local.pop_front();
+      return true;
+    }
+  }
+  return popInjected(Priority::LOW);
+}
+
+void ThreadPool::workerLoop(size_t index) {
+  t_worker = static_cast<int>(index) + 1;
+  t_pool = this;
+  for (;;) {
+    Task task;
+    if (takeTask(index, task)) {
+      pending_--;
+      PriorityScope scope(task.priority);
+      task.run();
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    wake_.wait(lock, [this] { return stopping_ || pending_.load() > 0; });
+    if (stopping_)
+      return;
+  }
+}
+
+void ThreadPool::parallelFor(int n, const std::function<void(int, int)> &body) {
+  if (n <= 0)
+    return;
+  const int threads = concurrency();
+  if (n == 1 || threads <= 1 || workers_.empty()) {
+    body(0, n);
+    return;
+  }
+
+  auto job = std::make_shared<ForJob>();
+  job->body = body;
+  job->n = n;
+  // A few chunks per thread so faster cores pick up the slack
+  job->chunks = std::min(n, threads * 4);
+  job->chunk_size = (n + job->chunks - 1) / job->chunks;
+  job->chunks = (n + job->chunk_size - 1) / job->chunk_size;
+
+  const int helpers = std::min(threads, job->chunks) - 1;
+  for (int i = 0; i < helpers; i++)
+    push({[job] { job->work(); }, t_priority});
+
+  job->work();
+  {
+    std::unique_lock<std::mutex> lock(job->mutex);
+    job->finished.wait(lock,
+                       [&job] { return job->done.load() == job->chunks; });
+  }
+  if (job->error)
+    std::rethrow_exception(job->error);
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// One work-stealing pool for the whole daemon. Installed as OpenCV's
+// parallel backend (parallel_backend.hpp), so DNN layers, resizes and HDR
+// merges share its workers instead of each parallel_for sizing a pool of
+// its own for the whole machine.
+//
+// Tasks submitted from a worker go to that worker's deque (run LIFO, stolen
+// FIFO by idle workers); tasks from other threads go to one injection queue
+// per priority. Workers take HIGH work before anything else and LOW work
+// only when idle, so background jobs (warm-up, re-probe) never delay an
+// authentication.
+class ThreadPool {
+public:
+  enum class Priority { HIGH = 0, NORMAL = 1, LOW = 2 };
+
+  // 0 = one worker per CPU in the affinity mask, minus the calling thread
+  explicit ThreadPool(size_t workers = 0);
+  ~ThreadPool();
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  size_t size() const { return workers_.size(); }
+
+  std::future<void> submit(std::function<void()> task);
+
+  // Run body(begin, end) over [0, n) in chunks. The caller takes chunks
+  // too, so nested calls from inside a task cannot deadlock.
+  void parallelFor(int n, const std::function<void(int, int)> &body);
+
+  // Upper bound on threads per parallelFor (caller included), 0 = all
+  int setConcurrency(int threads);
+  int concurrency() const;
+
+  // 1..size() on a worker, 0 elsewhere
+  static int workerIndex();
+
+  // Priority of work the calling thread submits, restored on destruction.
+  // Tasks inherit the priority they were submitted with.
+  class PriorityScope {
+  public:
+    explicit PriorityScope(Priority p);
+    ~PriorityScope();
+    PriorityScope(const PriorityScope &) = delete;
+    PriorityScope &operator=(const PriorityScope &) = delete;
+
+  private:
+    Priority saved_;
+  };
+
+private:
+  struct Task {
+    std::function<void()> run;
+    Priority priority = Priority::NORMAL;
+  };
+  struct Worker {
+    std::mutex mutex;
+    std::deque<Task> local;
+    std::thread thread;
+  };
+
+  void workerLoop(size_t index);
+  bool takeTask(size_t index, Task &task);
+  void push(Task task);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::mutex mutex_; // Guards the injection queues and the sleep
+  std::condition_variable wake_;
+  std::deque<Task> injected_[3];
+  std::atomic<size_t> pending_{0};
+  std::atomic<int> concurrency_{0};
+  bool stopping_ = false;
+};
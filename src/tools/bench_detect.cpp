@@ -0,0 +1,123 @@
+// Replays saved frames through single-stage and coarse-to-fine face detection
+// and reports latency and detection rate for both.
+//
+// Usage: bench_detect <yunet.onnx> <frames_dir> [coarse_w coarse_h fine_side]
+// Frames can be the success_/fail_ images written with save_*_images = true.
+
+#include "face_detector.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+struct Stats {
+  std::vector<double> latencies_ms;
+  int detected = 0;
+
+  double percentile(double p) const {
+    if (latencies_ms.empty())
+      return 0.0;
+    std::vector<double> sorted = latencies_ms;
+    std::sort(sorted.begin(), sorted.end());
+    size_t idx = static_cast<size_t>(p * (sorted.size() - 1));
+    return sorted[idx];
+  }
+  double mean() const {
+    if (latencies_ms.empty())
+      return 0.0;
+    double sum = 0.0;
+    for (double v : latencies_ms)
+      sum += v;
+    return sum / latencies_ms.size();
+  }
+};
+
+template <typename Fn>
+double timeMs(Fn &&fn) {
+  auto start = std::chrono::steady_clock::now();
+  fn();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void printRow(const std::string &name, const Stats &s, size_t frames) {
+  std::cout << std::left << std::setw(16) << name << std::right << std::fixed
+            << std::setprecision(2) << std::setw(10) << s.mean()
+            << std::setw(10) << s.percentile(0.5) << std::setw(10)
+            << s.percentile(0.95) << std::setw(9) << s.detected << "/"
+            << frames << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  if (argc < 3) {
+    std::cerr << "Usage: bench_detect <yunet.onnx> <frames_dir> "
+                 "[coarse_w coarse_h fine_side]"
+              << std::endl;
+    return 1;
+  }
+  std::string model = argv[1];
+  std::string frames_dir = argv[2];
+  cv::Size coarse(160, 120);
+  int fine_side = 320;
+  if (argc >= 6) {
+    coarse = cv::Size(std::stoi(argv[3]), std::stoi(argv[4]));
+    fine_side = std::stoi(argv[5]);
+  }
+
+  std::vector<cv::Mat> frames;
+  for (const auto &entry : fs::directory_iterator(frames_dir)) {
+    std::string ext = entry.path().extension().string();
+    if (ext != ".jpg" && ext != ".png")
+      continue;
+    cv::Mat img = cv::imread(entry.path().string());
+    if (!img.empty())
+      frames.push_back(img);
+  }
+  if (frames.empty()) {
+    std::cerr << "No .jpg/.png frames found in " << frames_dir << std::endl;
+    return 1;
+  }
+
+  DetectorCache detector(model, 0.6f, 0.3f, 5000, cv::dnn::DNN_BACKEND_OPENCV,
+                         cv::dnn::DNN_TARGET_CPU);
+  Stats full, two_stage;
+  int agree = 0;
+
+  for (const auto &frame : frames) {
+    cv::Mat faces_full, faces_two;
+    // Untimed warm-up so per-size network setup isn't counted
+    detector.detect(frame, faces_full);
+    detectCoarseToFine(detector, frame, coarse, cv::Size(fine_side, fine_side),
+                       1.6f, 0.3f, faces_two);
+
+    full.latencies_ms.push_back(
+        timeMs([&] { detector.detect(frame, faces_full); }));
+    two_stage.latencies_ms.push_back(timeMs([&] {
+      detectCoarseToFine(detector, frame, coarse,
+                         cv::Size(fine_side, fine_side), 1.6f, 0.3f, faces_two);
+    }));
+
+    full.detected += faces_full.rows > 0;
+    two_stage.detected += faces_two.rows > 0;
+    agree += (faces_full.rows > 0) == (faces_two.rows > 0);
+  }
+
+  std::cout << "Frames: " << frames.size() << "  coarse: " << coarse.width
+            << "x" << coarse.height << "  fine: " << fine_side << "x"
+            << fine_side << std::endl;
+  std::cout << std::left << std::setw(16) << "method" << std::right
+            << std::setw(10) << "mean ms" << std::setw(10) << "p50 ms"
+            << std::setw(10) << "p95 ms" << std::setw(12) << "detected"
+            << std::endl;
+  printRow("full-res", full, frames.size());
+  printRow("coarse-to-fine", two_stage, frames.size());
+  std::cout << "Detection agreement: " << agree << "/" << frames.size()
+            << std::endl;
+  return 0;
+}
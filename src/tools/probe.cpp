@@ -0,0 +1,85 @@
+// Benchmarks the face detector and recognizer on every DNN backend this
+// OpenCV build can use and stores the result where the daemon's
+// provider_priority = auto reads it.
+//
+// Usage: linuxcampam-probe [--iterations N] [--no-save]
+//                          [detector.onnx recognizer.onnx]
+// Without model arguments the packaged defaults are used.
+
+#include "backend_probe.hpp"
+#include "constants.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char *argv[]) {
+  int iterations = 10;
+  bool save = true;
+  std::vector<std::string> paths;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--iterations" && i + 1 < argc) {
+      iterations = std::max(1, std::stoi(argv[++i]));
+    } else if (arg == "--no-save") {
+      save = false;
+    } else if (arg.rfind("--", 0) == 0) {
+      std::cerr << "Usage: linuxcampam-probe [--iterations N] [--no-save] "
+                   "[detector.onnx recognizer.onnx]"
+                << std::endl;
+      return 1;
+    } else {
+      paths.push_back(arg);
+    }
+  }
+
+  ModelRegistry models = ModelRegistry::fromConfig(
+      [](const std::string &, const std::string &def) { return def; },
+      linuxcampam::MODELS_DIR);
+  if (paths.size() == 2) {
+    models.detection.path = paths[0];
+    models.detection.precision = parseModelPrecision("auto", paths[0]);
+    models.recognition.path = paths[1];
+    models.recognition.precision = parseModelPrecision("auto", paths[1]);
+  }
+  for (const ModelSpec *spec : {&models.detection, &models.recognition}) {
+    std::string reason;
+    if (!spec->supported(reason)) {
+      std::cerr << reason << std::endl;
+      return 1;
+    }
+  }
+
+  std::vector<BackendCandidate> candidates = availableBackends();
+  std::cout << "Probing " << candidates.size() << " backends ("
+            << iterations << " iterations each)..." << std::endl;
+  ProbeReport report = probeBackends(models.detection, models.recognition,
+                                     candidates, iterations);
+
+  std::cout << std::left << std::setw(14) << "Backend" << std::right
+            << std::setw(12) << "detect ms" << std::setw(14) << "recognize ms"
+            << std::setw(12) << "max error" << "  status" << std::endl;
+  for (const auto &r : report.results) {
+    std::cout << std::left << std::setw(14) << r.name << std::right
+              << std::fixed << std::setprecision(2) << std::setw(12)
+              << r.detect_ms << std::setw(14) << r.recognize_ms
+              << std::setprecision(4) << std::setw(12) << r.max_error << "  "
+              << (r.ok ? "ok" : r.error) << std::endl;
+  }
+
+  const ProbeResult *best = report.best();
+  std::cout << "\nSelected: " << (best ? best->name : "CPU (no backend passed)")
+            << std::endl;
+
+  if (save) {
+    if (!saveProbeReport(linuxcampam::PROBE_CACHE_PATH, report)) {
+      std::cerr << "Cannot write " << linuxcampam::PROBE_CACHE_PATH
+                << " (run as root, or use --no-save)" << std::endl;
+      return 1;
+    }
+    std::cout << "Saved to " << linuxcampam::PROBE_CACHE_PATH << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,74 @@
+#include "backend_probe.hpp"
+
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <opencv2/dnn.hpp>
+
+namespace fs = std::filesystem;
+
+namespace {
+ProbeResult result(const std::string &name, bool ok, double det, double rec) {
+  ProbeResult r;
+  r.name = name;
+  r.ok = ok;
+  r.detect_ms = det;
+  r.recognize_ms = rec;
+  return r;
+}
+} // namespace
+
+TEST(BackendProbeTest, BestSkipsFailedBackends) {
+  ProbeReport report;
+  EXPECT_EQ(report.best(), nullptr);
+
+  report.results = {result("CPU", true, 8.0, 3.0),
+                    result("OpenCL", true, 12.0, 4.0),
+                    result("OpenCL-FP16", false, 2.0, 1.0)};
+  ASSERT_NE(report.best(), nullptr);
+  EXPECT_EQ(report.best()->name, "CPU");
+}
+
+TEST(BackendProbeTest, NoBestWithoutCPUReference) {
+  // An accelerated backend compared against itself would pass trivially
+  ProbeReport report;
+  report.results = {result("CPU", false, 0.0, 0.0),
+                    result("OpenCL", true, 2.0, 1.0)};
+  EXPECT_EQ(report.best(), nullptr);
+}
+
+TEST(BackendProbeTest, ProviderNames) {
+  auto cpu = providerCandidates("CPU");
+  ASSERT_EQ(cpu.size(), 1u);
+  EXPECT_EQ(cpu[0].target_id, cv::dnn::DNN_TARGET_CPU);
+  EXPECT_TRUE(isBackendAvailable(cpu[0]));
+
+  EXPECT_EQ(providerCandidates("opencl").size(), 2u);
+  EXPECT_TRUE(providerCandidates("rocm").empty());
+
+  auto available = availableBackends();
+  ASSERT_FALSE(available.empty());
+  EXPECT_EQ(available[0].name, "CPU");
+}
+
+TEST(BackendProbeTest, ReportRoundTripAndKeyCheck) {
+  fs::path path = fs::temp_directory_path() / "linuxcampam_probe_test.json";
+  ProbeReport report;
+  report.key = "opencv=4.6.0;cpu=test";
+  report.results = {result("CPU", true, 8.5, 3.25),
+                    result("OpenVINO", false, 0.0, 0.0)};
+  report.results[1].error = "not installed";
+  ASSERT_TRUE(saveProbeReport(path.string(), report));
+
+  ProbeReport loaded;
+  ASSERT_TRUE(loadProbeReport(path.string(), report.key, loaded));
+  ASSERT_EQ(loaded.results.size(), 2u);
+  EXPECT_DOUBLE_EQ(loaded.results[0].detect_ms, 8.5);
+  EXPECT_EQ(loaded.results[1].error, "not installed");
+  EXPECT_FALSE(loaded.results[1].ok);
+
+  // New OpenCV build or hardware: stale report is ignored
+  EXPECT_FALSE(loadProbeReport(path.string(), "opencv=4.10.0;cpu=test",
+                               loaded));
+  fs::remove(path);
+  EXPECT_FALSE(loadProbeReport(path.string(), report.key, loaded));
+}
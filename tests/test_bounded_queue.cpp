@@ -0,0 +1,65 @@
+#include "bounded_queue.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+
+TEST(BoundedQueueTest, FifoOrder) {
+  BoundedQueue<int> q(3);
+  EXPECT_TRUE(q.push(1));
+  EXPECT_TRUE(q.push(2));
+  int v = 0;
+  ASSERT_TRUE(q.pop(v));
+  EXPECT_EQ(v, 1);
+  ASSERT_TRUE(q.pop(v));
+  EXPECT_EQ(v, 2);
+}
+
+TEST(BoundedQueueTest, FullQueueBlocksProducer) {
+  BoundedQueue<int> q(2);
+  std::atomic<int> pushed{0};
+  std::thread producer([&] {
+    for (int i = 0; i < 5; i++) {
+      if (!q.push(i))
+        break;
+      pushed++;
+    }
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(pushed.load(), 2);
+  int v = 0;
+  for (int i = 0; i < 5; i++) {
+    ASSERT_TRUE(q.pop(v));
+    EXPECT_EQ(v, i);
+  }
+  producer.join();
+  EXPECT_EQ(pushed.load(), 5);
+}
+
+TEST(BoundedQueueTest, CloseDrainsThenStops) {
+  BoundedQueue<int> q(4);
+  q.push(7);
+  q.close();
+  EXPECT_FALSE(q.push(8));
+  int v = 0;
+  ASSERT_TRUE(q.pop(v));
+  EXPECT_EQ(v, 7);
+  EXPECT_FALSE(q.pop(v));
+}
+
+TEST(BoundedQueueTest, CloseWakesBlockedSides) {
+  BoundedQueue<int> full(1);
+  full.push(0);
+  std::thread producer([&] { EXPECT_FALSE(full.push(1)); });
+  BoundedQueue<int> empty(1);
+  std::thread consumer([&] {
+    int v;
+    EXPECT_FALSE(empty.pop(v));
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  full.close();
+  empty.close();
+  producer.join();
+  consumer.join();
+}
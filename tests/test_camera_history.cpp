@@ -0,0 +1,59 @@
+#include "camera_history.hpp"
+
+#include <filesystem>
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+
+TEST(CameraHistoryTest, StatsTrackRateAndMedian) {
+  CameraStats s;
+  EXPECT_DOUBLE_EQ(s.successRate(), 0.5);
+  EXPECT_DOUBLE_EQ(s.medianLatency(), 0.0);
+  s.record(true, 300.0);
+  s.record(true, 100.0);
+  s.record(false, 200.0);
+  EXPECT_DOUBLE_EQ(s.successRate(), 3.0 / 5.0);
+  EXPECT_DOUBLE_EQ(s.medianLatency(), 200.0);
+}
+
+TEST(CameraHistoryTest, WindowsOldRuns) {
+  CameraStats s;
+  for (int i = 0; i < 100; i++)
+    s.record(false, 50.0);
+  EXPECT_LE(s.attempts, CameraStats::kMaxAttempts);
+  EXPECT_EQ(s.latency_ms.size(), CameraStats::kWindow);
+}
+
+TEST(CameraHistoryTest, OrderDependsOnPolicy) {
+  CameraHistory h;
+  // "ir" matches reliably but slowly; "rgb" is fast and usually fails
+  for (int i = 0; i < 10; i++) {
+    h.at("ir").record(true, 400.0);
+    h.at("rgb").record(false, 150.0);
+  }
+  std::vector<std::string> ids = {"new", "rgb", "ir"};
+  EXPECT_EQ(h.order(ids, true), (std::vector<size_t>{2, 1, 0}));
+  EXPECT_EQ(h.order(ids, false), (std::vector<size_t>{1, 2, 0}));
+}
+
+TEST(CameraHistoryTest, SaveAndLoadRoundTrip) {
+  const std::string path =
+      (fs::temp_directory_path() / "linuxcampam_camera_history.json").string();
+  CameraHistory h;
+  h.at("ir").record(true, 120.0);
+  h.at("ir").record(false, 180.0);
+  ASSERT_TRUE(h.save(path));
+
+  CameraHistory loaded;
+  ASSERT_TRUE(loaded.load(path));
+  const CameraStats *s = loaded.find("ir");
+  ASSERT_NE(s, nullptr);
+  EXPECT_EQ(s->attempts, 2);
+  EXPECT_EQ(s->successes, 1);
+  EXPECT_DOUBLE_EQ(s->medianLatency(), 150.0);
+  EXPECT_EQ(loaded.find("rgb"), nullptr);
+  fs::remove(path);
+
+  EXPECT_FALSE(loaded.load(path));
+  EXPECT_NE(loaded.find("ir"), nullptr); // Kept on a failed load
+}
@@ -0,0 +1,84 @@
+#include "cpu_affinity.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+
+TEST(CpuAffinityTest, ParsesCpuLists) {
+  EXPECT_EQ(parseCpuList("0-3,8,10-11"),
+            (std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+  EXPECT_EQ(parseCpuList(" 4 , 2,2 "), (std::vector<int>{2, 4}));
+  EXPECT_TRUE(parseCpuList("").empty());
+  EXPECT_TRUE(parseCpuList("3-1").empty());
+  EXPECT_TRUE(parseCpuList("a-b").empty());
+  EXPECT_TRUE(parseCpuList("1x").empty());
+}
+
+TEST(CpuAffinityTest, FormatsRanges) {
+  EXPECT_EQ(formatCpuList({0, 1, 2, 3, 8, 10, 11}), "0-3,8,10-11");
+  EXPECT_EQ(formatCpuList({}), "");
+}
+
+// Fake /sys/devices/system/cpu of a hybrid laptop: 4 P-cores, 4 E-cores
+class CpuTopologyTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    root_ = fs::temp_directory_path() / "linuxcampam_cpu_test";
+    fs::remove_all(root_);
+    fs::create_directories(root_);
+    std::ofstream(root_ / "online") << "0-7\n";
+  }
+  void TearDown() override { fs::remove_all(root_); }
+
+  void write(int cpu, const std::string &attr, long value) {
+    fs::path p = root_ / ("cpu" + std::to_string(cpu)) / attr;
+    fs::create_directories(p.parent_path());
+    std::ofstream(p) << value << "\n";
+  }
+
+  fs::path root_;
+};
+
+TEST_F(CpuTopologyTest, PicksHighestMaxFrequency) {
+  for (int c = 0; c < 8; c++)
+    write(c, "cpufreq/cpuinfo_max_freq", c < 4 ? 4700000 : 3400000);
+  EXPECT_EQ(fastestCpus(root_.string()), (std::vector<int>{0, 1, 2, 3}));
+}
+
+TEST_F(CpuTopologyTest, CapacityWinsOverFrequency) {
+  for (int c = 0; c < 8; c++) {
+    write(c, "cpu_capacity", c >= 6 ? 1024 : 446);
+    write(c, "cpufreq/cpuinfo_max_freq", 2000000);
+  }
+  EXPECT_EQ(fastestCpus(root_.string()), (std::vector<int>{6, 7}));
+}
+
+TEST_F(CpuTopologyTest, BoostedCoresWithinToleranceCount) {
+  // Favoured cores boost slightly higher than their siblings
+  for (int c = 0; c < 8; c++)
+    write(c, "cpufreq/cpuinfo_max_freq", c == 2 ? 5000000 : 4900000);
+  EXPECT_EQ(fastestCpus(root_.string()).size(), 8u);
+}
+
+TEST_F(CpuTopologyTest, NoTopologyMeansAllOnline) {
+  EXPECT_EQ(fastestCpus(root_.string()).size(), 8u);
+}
+
+TEST(CpuAffinityTest, TuningRestoresAffinity) {
+  std::vector<int> before = threadAffinity();
+  ASSERT_FALSE(before.empty());
+  {
+    ThreadTuning tuning({before.front()}, SchedMode::NORMAL);
+    EXPECT_TRUE(tuning.ok());
+    EXPECT_EQ(threadAffinity(), std::vector<int>{before.front()});
+  }
+  EXPECT_EQ(threadAffinity(), before);
+}
+
+TEST(CpuAffinityTest, ParsesSchedModes) {
+  EXPECT_EQ(parseSchedMode("fifo"), SchedMode::FIFO);
+  EXPECT_EQ(parseSchedMode("nice"), SchedMode::NICE);
+  EXPECT_EQ(parseSchedMode("other"), SchedMode::NORMAL);
+}
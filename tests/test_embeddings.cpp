@@ -1,3 +1,5 @@
+#include "model_registry.hpp"
+
 #include <ctime>
 #include <gtest/gtest.h>
 #include <string>
@@ -100,3 +102,30 @@ TEST(EmbeddingFormatTest, ParseEmbeddingData) {
   EXPECT_FLOAT_EQ(data[0], 0.1f);
   EXPECT_FLOAT_EQ(data[4], 0.5f);
 }
+
+TEST(EmbeddingFormatTest, CascadeVariants) {
+  json j;
+  json e1;
+  e1["label"] = "default";
+  e1["data"] = std::vector<float>{0.1f, 0.2f};
+  e1["variants"]["sface_2021dec_int8"] = std::vector<float>{0.3f, 0.4f};
+  j["embeddings_ir"].push_back(e1);
+
+  auto variants = loadVariantEmbeddings(j, "ir", "sface_2021dec_int8", 2);
+  ASSERT_EQ(variants.size(), 1u);
+  EXPECT_FLOAT_EQ(variants[0][1], 0.4f);
+  // Enrolled with a fast model of another size: not usable
+  EXPECT_TRUE(
+      loadVariantEmbeddings(j, "ir", "sface_2021dec_int8", 128).empty());
+  EXPECT_EQ(
+      loadVariantEmbeddings(j, "ir", "sface_2021dec_int8", 0).size(), 1u);
+  EXPECT_TRUE(loadVariantEmbeddings(j, "ir", "other_model", 2).empty());
+  EXPECT_TRUE(loadVariantEmbeddings(j, "rgb", "sface_2021dec_int8", 2).empty());
+
+  // An entry without the variant disables the fast stage for the camera
+  json e2;
+  e2["label"] = "glasses";
+  e2["data"] = std::vector<float>{0.5f, 0.6f};
+  j["embeddings_ir"].push_back(e2);
+  EXPECT_TRUE(loadVariantEmbeddings(j, "ir", "sface_2021dec_int8", 2).empty());
+}
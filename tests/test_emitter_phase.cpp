@@ -0,0 +1,105 @@
+#include "emitter_phase.hpp"
+
+#include <gtest/gtest.h>
+
+TEST(EmitterPhaseTest, SampleBrightness) {
+  cv::Mat gray(120, 160, CV_8UC1, cv::Scalar(77));
+  EXPECT_FLOAT_EQ(EmitterPhaseTracker::sampleBrightness(gray), 77.0f);
+
+  // First channel only (IR cameras often deliver gray replicated to BGR)
+  cv::Mat bgr(120, 160, CV_8UC3, cv::Scalar(50, 200, 200));
+  EXPECT_FLOAT_EQ(EmitterPhaseTracker::sampleBrightness(bgr), 50.0f);
+
+  EXPECT_FLOAT_EQ(EmitterPhaseTracker::sampleBrightness(cv::Mat()), 0.0f);
+}
+
+TEST(EmitterPhaseTest, LearnsAlternatingStrobe) {
+  EmitterPhaseTracker phase;
+  EXPECT_TRUE(phase.observe(180.0f));
+  EXPECT_FALSE(phase.observe(15.0f));
+  EXPECT_TRUE(phase.observe(175.0f));
+  EXPECT_FALSE(phase.observe(18.0f));
+  EXPECT_EQ(phase.period(), 2);
+
+  // Next frame is lit, the one after that dark
+  EXPECT_TRUE(phase.predictNextLit());
+  EXPECT_TRUE(phase.observe(182.0f));
+  EXPECT_FALSE(phase.predictNextLit());
+
+  // Skipping the dark frame keeps the phase
+  phase.skip();
+  EXPECT_TRUE(phase.predictNextLit());
+}
+
+TEST(EmitterPhaseTest, LearnsLongerPeriod) {
+  EmitterPhaseTracker phase;
+  const float pattern[] = {160.0f, 165.0f, 12.0f};
+  for (int i = 0; i < 9; i++)
+    phase.observe(pattern[i % 3]);
+  EXPECT_EQ(phase.period(), 3);
+  EXPECT_TRUE(phase.predictNextLit());
+}
+
+TEST(EmitterPhaseTest, SteadyEmitterIsAlwaysLit) {
+  EmitterPhaseTracker phase;
+  const float noise[] = {120.0f, 123.0f, 118.0f, 121.0f, 125.0f, 119.0f};
+  for (int i = 0; i < 24; i++)
+    EXPECT_TRUE(phase.observe(noise[i % 6]));
+  EXPECT_EQ(phase.period(), 0);
+  EXPECT_TRUE(phase.predictNextLit());
+}
+
+TEST(EmitterPhaseTest, PhaseSlipForgetsPeriod) {
+  EmitterPhaseTracker phase;
+  for (int i = 0; i < 6; i++)
+    phase.observe(i % 2 == 0 ? 180.0f : 15.0f);
+  ASSERT_EQ(phase.period(), 2);
+
+  // A dropped frame shifts the pattern: predicted lit, arrives dark
+  EXPECT_TRUE(phase.predictNextLit());
+  EXPECT_FALSE(phase.observe(15.0f));
+  EXPECT_EQ(phase.period(), 0);
+  EXPECT_TRUE(phase.predictNextLit());
+
+  phase.reset();
+  EXPECT_EQ(phase.period(), 0);
+}
+
+namespace {
+// Camera::readLit in short: skip predicted-dark frames, read the rest
+void feed(EmitterPhaseTracker &phase, float brightness, int *observed_dark) {
+  if (!phase.predictNextLit()) {
+    phase.skip();
+    return;
+  }
+  if (!phase.observe(brightness) && observed_dark)
+    (*observed_dark)++;
+}
+} // namespace
+
+TEST(EmitterPhaseTest, RecheckConfirmsStrobe) {
+  EmitterPhaseTracker phase(12.0f, 6, 4);
+  int observed_dark = 0;
+  for (int i = 0; i < 40; i++)
+    feed(phase, i % 2 == 0 ? 180.0f : 15.0f, &observed_dark);
+  EXPECT_EQ(phase.period(), 2);
+  EXPECT_GT(observed_dark, 2); // Predicted-dark frames were looked at
+}
+
+TEST(EmitterPhaseTest, StrobeStopsPeriodForgotten) {
+  EmitterPhaseTracker phase(12.0f, 6, 4);
+  for (int i = 0; i < 12; i++)
+    feed(phase, i % 2 == 0 ? 180.0f : 15.0f, nullptr);
+  ASSERT_EQ(phase.period(), 2);
+
+  // Emitter switches to steady-on: every frame is lit from now on
+  int skipped = 0;
+  for (int i = 0; i < 40; i++) {
+    if (!phase.predictNextLit())
+      skipped++;
+    feed(phase, 180.0f, nullptr);
+  }
+  EXPECT_EQ(phase.period(), 0);
+  EXPECT_TRUE(phase.predictNextLit());
+  EXPECT_LE(skipped, 4);
+}
@@ -0,0 +1,94 @@
+#include "face_quality.hpp"
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <opencv2/opencv.hpp>
+
+// FaceDetectorYN-style row with explicit eye and nose positions
+static cv::Mat makeFace(cv::Rect box, cv::Point2f re, cv::Point2f le,
+                        cv::Point2f nose) {
+  cv::Mat face = cv::Mat::zeros(1, 15, CV_32F);
+  float *f = face.ptr<float>(0);
+  f[0] = box.x;
+  f[1] = box.y;
+  f[2] = box.width;
+  f[3] = box.height;
+  f[4] = re.x;
+  f[5] = re.y;
+  f[6] = le.x;
+  f[7] = le.y;
+  f[8] = nose.x;
+  f[9] = nose.y;
+  f[14] = 0.9f;
+  return face;
+}
+
+TEST(FaceQualityTest, FrontalFaceGeometry) {
+  cv::Mat frame(200, 200, CV_8UC3, cv::Scalar(128, 128, 128));
+  cv::Mat face = makeFace({50, 50, 100, 100}, {80, 90}, {120, 90}, {100, 115});
+  FaceQuality q = assessFaceQuality(frame, face);
+  EXPECT_NEAR(q.interocular_px, 40.0f, 1e-3f);
+  EXPECT_NEAR(q.roll_deg, 0.0f, 1e-3f);
+  EXPECT_NEAR(q.yaw_deg, 0.0f, 1e-3f);
+  EXPECT_NEAR(q.brightness, 128.0f, 0.5f);
+}
+
+TEST(FaceQualityTest, RollAndYaw) {
+  cv::Mat frame(200, 200, CV_8UC3, cv::Scalar(128, 128, 128));
+  // Eye line rotated 45 degrees
+  cv::Mat tilted =
+      makeFace({50, 50, 100, 100}, {80, 80}, {120, 120}, {95, 105});
+  EXPECT_NEAR(assessFaceQuality(frame, tilted).roll_deg, 45.0f, 1e-3f);
+
+  // Nose shifted sideways by a full eye distance: strongly turned head
+  cv::Mat turned =
+      makeFace({50, 50, 100, 100}, {80, 90}, {120, 90}, {140, 115});
+  EXPECT_GT(std::abs(assessFaceQuality(frame, turned).yaw_deg), 45.0f);
+}
+
+TEST(FaceQualityTest, BlurLowersSharpness) {
+  cv::Mat sharp(200, 200, CV_8UC3);
+  cv::RNG rng(1);
+  rng.fill(sharp, cv::RNG::UNIFORM, 0, 255);
+  cv::Mat blurred;
+  cv::GaussianBlur(sharp, blurred, cv::Size(15, 15), 5.0);
+
+  cv::Mat face = makeFace({50, 50, 100, 100}, {80, 90}, {120, 90}, {100, 115});
+  EXPECT_GT(assessFaceQuality(sharp, face).sharpness,
+            10.0f * assessFaceQuality(blurred, face).sharpness);
+}
+
+TEST(FaceQualityTest, LimitsGate) {
+  QualityLimits limits;
+  limits.min_sharpness = 10.0f;
+  limits.max_yaw_deg = 30.0f;
+  limits.max_roll_deg = 20.0f;
+  limits.min_interocular_px = 20.0f;
+  limits.min_brightness = 30.0f;
+  limits.max_brightness = 230.0f;
+
+  FaceQuality good;
+  good.sharpness = 100.0f;
+  good.interocular_px = 50.0f;
+  good.brightness = 120.0f;
+  EXPECT_EQ(checkFaceQuality(good, limits), "");
+
+  FaceQuality q = good;
+  q.sharpness = 2.0f;
+  EXPECT_EQ(checkFaceQuality(q, limits), "face blurred");
+  q = good;
+  q.yaw_deg = -40.0f;
+  EXPECT_EQ(checkFaceQuality(q, limits), "head turned");
+  q = good;
+  q.roll_deg = 25.0f;
+  EXPECT_EQ(checkFaceQuality(q, limits), "head tilted");
+  q = good;
+  q.interocular_px = 10.0f;
+  EXPECT_EQ(checkFaceQuality(q, limits), "face too small");
+  q = good;
+  q.brightness = 10.0f;
+  EXPECT_EQ(checkFaceQuality(q, limits), "face underexposed");
+
+  // Zero limits disable the checks
+  EXPECT_EQ(checkFaceQuality(FaceQuality{}, QualityLimits{}), "");
+}
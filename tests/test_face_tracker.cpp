@@ -0,0 +1,73 @@
+#include "face_tracker.hpp"
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <opencv2/opencv.hpp>
+
+// Build a FaceDetectorYN-style row: box, 5 landmarks, score
+static cv::Mat makeFace(float x, float y, float w, float h) {
+  cv::Mat face(1, 15, CV_32F);
+  float *f = face.ptr<float>(0);
+  f[0] = x;
+  f[1] = y;
+  f[2] = w;
+  f[3] = h;
+  const float lm[10] = {0.3f, 0.4f, 0.7f, 0.4f, 0.5f,
+                        0.6f, 0.35f, 0.8f, 0.65f, 0.8f};
+  for (int k = 0; k < 5; k++) {
+    f[4 + 2 * k] = x + lm[2 * k] * w;
+    f[5 + 2 * k] = y + lm[2 * k + 1] * h;
+  }
+  f[14] = 0.95f;
+  return face;
+}
+
+// Textured frame with the "face" patch pasted at (x, y)
+static cv::Mat makeFrame(const cv::Mat &patch, int x, int y) {
+  cv::Mat frame(240, 320, CV_8UC3, cv::Scalar(40, 40, 40));
+  patch.copyTo(frame(cv::Rect(x, y, patch.cols, patch.rows)));
+  return frame;
+}
+
+TEST(FaceTrackerTest, FollowsTranslatedFace) {
+  cv::Mat patch(64, 64, CV_8UC3);
+  cv::RNG rng(42);
+  rng.fill(patch, cv::RNG::UNIFORM, 0, 255);
+
+  FaceTracker tracker(0.6f);
+  tracker.init(makeFrame(patch, 100, 80), makeFace(100, 80, 64, 64));
+  ASSERT_TRUE(tracker.active());
+
+  cv::Mat face;
+  ASSERT_TRUE(tracker.update(makeFrame(patch, 106, 77), face));
+  EXPECT_NEAR(face.at<float>(0, 0), 106.0f, 1.0f);
+  EXPECT_NEAR(face.at<float>(0, 1), 77.0f, 1.0f);
+  // Landmarks move with the box
+  EXPECT_NEAR(face.at<float>(0, 4), 106.0f + 0.3f * 64, 1.0f);
+  EXPECT_GT(tracker.confidence(), 0.9f);
+}
+
+TEST(FaceTrackerTest, LosesFaceWhenItDisappears) {
+  cv::Mat patch(64, 64, CV_8UC3);
+  cv::RNG rng(7);
+  rng.fill(patch, cv::RNG::UNIFORM, 0, 255);
+
+  FaceTracker tracker(0.6f);
+  tracker.init(makeFrame(patch, 100, 80), makeFace(100, 80, 64, 64));
+
+  cv::Mat other(64, 64, CV_8UC3);
+  rng.fill(other, cv::RNG::UNIFORM, 0, 255);
+  cv::Mat face;
+  EXPECT_FALSE(tracker.update(makeFrame(other, 100, 80), face));
+  EXPECT_FALSE(tracker.active());
+}
+
+TEST(FaceTrackerTest, AlignmentChange) {
+  cv::Mat a = makeFace(100, 80, 100, 100);
+  EXPECT_FLOAT_EQ(alignmentChange(a, a), 0.0f);
+
+  cv::Mat b = makeFace(110, 80, 100, 100); // 10 px shift, 100 px box
+  EXPECT_NEAR(alignmentChange(a, b), 0.1f, 1e-5f);
+
+  EXPECT_TRUE(std::isinf(alignmentChange(cv::Mat(), a)));
+}
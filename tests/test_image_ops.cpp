@@ -0,0 +1,90 @@
+#include "image_ops.hpp"
+
+#include <gtest/gtest.h>
+#include <opencv2/core/ocl.hpp>
+
+// The UMat pipeline must not change results on hosts without OpenCL, where
+// the transparent API falls back to the CPU code paths.
+class ImageOpsTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    saved_ = cv::ocl::useOpenCL();
+    cv::ocl::setUseOpenCL(false);
+    cv::RNG rng(42);
+    for (int i = 0; i < 5; i++) {
+      cv::Mat f(48, 64, CV_8UC3);
+      rng.fill(f, cv::RNG::UNIFORM, cv::Scalar::all(0), cv::Scalar::all(256));
+      frames_.push_back(f);
+    }
+  }
+  void TearDown() override { cv::ocl::setUseOpenCL(saved_); }
+
+  bool saved_ = false;
+  std::vector<cv::Mat> frames_;
+};
+
+namespace {
+bool identical(const cv::Mat &a, cv::InputArray b) {
+  cv::Mat bm = b.getMat();
+  return a.size() == bm.size() && a.type() == bm.type() &&
+         cv::norm(a, bm, cv::NORM_INF) == 0.0;
+}
+
+// Previous Camera::captureAveraged arithmetic (copy for testing)
+cv::Mat legacyAverage(const std::vector<cv::Mat> &frames) {
+  cv::Mat sum = cv::Mat::zeros(frames[0].size(), CV_32FC3);
+  for (const auto &f : frames) {
+    cv::Mat f32;
+    f.convertTo(f32, CV_32FC3);
+    sum += f32;
+  }
+  sum /= static_cast<float>(frames.size());
+  cv::Mat result;
+  sum.convertTo(result, CV_8UC3);
+  return result;
+}
+} // namespace
+
+TEST_F(ImageOpsTest, FrameInputPrefersDeviceCopy) {
+  cv::UMat uframe;
+  EXPECT_FALSE(frameInput(frames_[0], uframe).isUMat());
+  frames_[0].copyTo(uframe);
+  EXPECT_TRUE(frameInput(frames_[0], uframe).isUMat());
+}
+
+TEST_F(ImageOpsTest, BrightnessMatchesOnUMat) {
+  cv::UMat u;
+  frames_[0].copyTo(u);
+  EXPECT_DOUBLE_EQ(meanBrightness(frames_[0]), meanBrightness(u));
+  EXPECT_DOUBLE_EQ(meanBrightness(cv::Mat()), 0.0);
+}
+
+TEST_F(ImageOpsTest, AverageMatchesLegacyAndUMat) {
+  cv::Mat avg;
+  averageFrames(frames_, avg);
+  EXPECT_TRUE(identical(legacyAverage(frames_), avg));
+
+  cv::UMat uavg;
+  averageFrames(frames_, uavg);
+  EXPECT_TRUE(identical(avg, uavg));
+}
+
+TEST_F(ImageOpsTest, DetectorDownscaleMatchesOnUMat) {
+  cv::UMat u, usmall;
+  frames_[0].copyTo(u);
+  cv::Mat small;
+  cv::resize(frames_[0], small, cv::Size(), 0.5, 0.5, cv::INTER_AREA);
+  cv::resize(u, usmall, cv::Size(), 0.5, 0.5, cv::INTER_AREA);
+  EXPECT_TRUE(identical(small, usmall));
+}
+
+TEST_F(ImageOpsTest, AlignmentWarpMatchesOnUMat) {
+  // alignCrop is a similarity warpAffine to 112x112
+  cv::Mat m = cv::getRotationMatrix2D(cv::Point2f(32, 24), 10.0, 1.5);
+  cv::UMat u, ucrop;
+  frames_[0].copyTo(u);
+  cv::Mat crop;
+  cv::warpAffine(frames_[0], crop, m, cv::Size(112, 112), cv::INTER_LINEAR);
+  cv::warpAffine(u, ucrop, m, cv::Size(112, 112), cv::INTER_LINEAR);
+  EXPECT_TRUE(identical(crop, ucrop));
+}
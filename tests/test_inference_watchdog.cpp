@@ -0,0 +1,75 @@
+#include "inference_watchdog.hpp"
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+
+TEST(InferenceWatchdogTest, TripsAfterConsecutiveOverruns) {
+  InferenceWatchdog dog(100.0, 3);
+  EXPECT_FALSE(dog.record(150.0));
+  EXPECT_FALSE(dog.record(150.0));
+  EXPECT_TRUE(dog.record(150.0));
+  EXPECT_EQ(dog.strikes(), 3);
+}
+
+TEST(InferenceWatchdogTest, FastRunClearsStrikes) {
+  InferenceWatchdog dog(100.0, 3);
+  EXPECT_FALSE(dog.record(150.0));
+  EXPECT_FALSE(dog.record(150.0));
+  EXPECT_FALSE(dog.record(20.0));
+  EXPECT_EQ(dog.strikes(), 0);
+  EXPECT_FALSE(dog.record(150.0));
+}
+
+TEST(InferenceWatchdogTest, FailureTripsImmediately) {
+  InferenceWatchdog dog(100.0, 3);
+  EXPECT_TRUE(dog.fail());
+  EXPECT_EQ(dog.failures(), 1);
+  dog.reset();
+  EXPECT_EQ(dog.failures(), 0);
+  EXPECT_DOUBLE_EQ(dog.median(), 0.0);
+}
+
+TEST(InferenceWatchdogTest, ZeroBudgetOnlyMeasures) {
+  InferenceWatchdog dog(0.0, 1);
+  EXPECT_FALSE(dog.record(10.0));
+  EXPECT_FALSE(dog.record(30.0));
+  EXPECT_FALSE(dog.record(20.0));
+  EXPECT_DOUBLE_EQ(dog.median(), 20.0);
+  EXPECT_DOUBLE_EQ(dog.last(), 20.0);
+}
+
+TEST(InferenceWatchdogTest, FailedRunLeavesStateForRetry) {
+  // Shaped like scoreFrames: a face whose alignment matches the last
+  // recognized one is skipped, counters grow per pass
+  struct Frame {
+    std::string face = "row0";
+    std::string scored_face;
+    bool scored = false;
+    int low_quality = 0;
+    int fast_decisions = 0;
+  };
+  int runs = 0;
+  auto stage = [&runs](Frame &f) {
+    f.scored = false;
+    if (f.scored_face == f.face)
+      return;
+    f.scored_face = f.face;
+    f.low_quality++;
+    f.fast_decisions++;
+    if (runs++ == 0)
+      throw std::runtime_error("accelerator failed mid-pass");
+    f.scored = true;
+  };
+
+  Frame frame;
+  EXPECT_THROW(commitOnSuccess(frame, stage), std::runtime_error);
+  EXPECT_TRUE(frame.scored_face.empty());
+  EXPECT_EQ(frame.low_quality, 0);
+
+  commitOnSuccess(frame, stage); // The CPU retry
+  EXPECT_TRUE(frame.scored);
+  EXPECT_EQ(frame.scored_face, "row0");
+  EXPECT_EQ(frame.low_quality, 1);
+  EXPECT_EQ(frame.fast_decisions, 1);
+}
@@ -0,0 +1,77 @@
+#include "memory_lock.hpp"
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+TEST(MemoryLockTest, ParsesOnlyPrivateAnonymousWritable) {
+  auto regions = parseMaps(
+      "55d0a0000000-55d0a0002000 r--p 00000000 fe:00 1 /usr/bin/linuxcampamd\n"
+      "55d0a0010000-55d0a0020000 rw-p 00000000 00:00 0 [heap]\n"
+      "7f0000000000-7f0000100000 rw-p 00000000 00:00 0 \n"
+      "7f0000100000-7f0000101000 ---p 00000000 00:00 0 \n"
+      "7f0000200000-7f0000300000 rw-s 00000000 00:05 9 /dev/dri/renderD128\n"
+      "7f0000400000-7f0000401000 rw-p 00001000 fe:00 2 /usr/lib/libc.so.6\n"
+      "7ffd00000000-7ffd00021000 rw-p 00000000 00:00 0 [stack]\n");
+  ASSERT_EQ(regions.size(), 2u);
+  EXPECT_EQ(regions[0].start, 0x55d0a0010000u);
+  EXPECT_EQ(regions[0].size(), 0x10000u);
+  EXPECT_EQ(regions[1].size(), 0x100000u);
+}
+
+TEST(MemoryLockTest, SkipsThreadStacks) {
+  auto regions = parseMaps(
+      // glibc thread stack: one guard page, then the stack
+      "7f1000000000-7f1000001000 ---p 00000000 00:00 0 \n"
+      "7f1000001000-7f1000801000 rw-p 00000000 00:00 0 \n"
+      // Malloc arena: the unused part of its reservation lies above
+      "7f2000000000-7f2000400000 rw-p 00000000 00:00 0 \n"
+      "7f2000400000-7f2004000000 ---p 00000000 00:00 0 \n"
+      // Adjacent to a large PROT_NONE reservation, not a guard page
+      "7f2004000000-7f2004100000 rw-p 00000000 00:00 0 \n");
+  ASSERT_EQ(regions.size(), 2u);
+  EXPECT_EQ(regions[0].start, 0x7f2000000000u);
+  EXPECT_EQ(regions[1].start, 0x7f2004000000u);
+
+  // The calling thread's own stack, e.g. the warm-up thread's
+  uintptr_t local = 0;
+  std::vector<MemoryRegion> live;
+  std::thread([&] {
+    int x = 0;
+    local = reinterpret_cast<uintptr_t>(&x);
+    live = readMaps();
+  }).join();
+  for (const auto &r : live)
+    EXPECT_FALSE(local >= r.start && local < r.end);
+}
+
+TEST(MemoryLockTest, GrownRegionsAreNewOrExtendedRanges) {
+  std::vector<MemoryRegion> before = {{0x1000, 0x5000}, {0x9000, 0xa000}};
+  std::vector<MemoryRegion> after = {
+      {0x1000, 0x8000}, // Heap grew by 0x3000
+      {0x9000, 0xa000}, // Unchanged
+      {0xc000, 0xe000}, // New mapping
+  };
+  auto grown = grownRegions(before, after);
+  ASSERT_EQ(grown.size(), 2u);
+  EXPECT_EQ(grown[0].start, 0x5000u);
+  EXPECT_EQ(grown[0].end, 0x8000u);
+  EXPECT_EQ(grown[1].start, 0xc000u);
+  EXPECT_EQ(grown[1].end, 0xe000u);
+}
+
+TEST(MemoryLockTest, LockRespectsCap) {
+  const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  std::vector<char> buffer(8 * page, 1);
+  MemoryLocker locker(2 * page);
+  size_t n = locker.lock(buffer.data(), buffer.size());
+  if (n == 0)
+    GTEST_SKIP() << "mlock not permitted here";
+  EXPECT_LE(locker.locked(), 2 * page);
+  EXPECT_TRUE(locker.limited());
+  EXPECT_EQ(locker.lock(buffer.data(), page), 0u);
+  locker.unlockAll();
+  EXPECT_EQ(locker.locked(), 0u);
+  EXPECT_FALSE(locker.limited());
+}
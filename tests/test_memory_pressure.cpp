@@ -0,0 +1,99 @@
+#include "memory_pressure.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+
+// Fake PSI / memory.events files, rewritten between polls
+class MemoryPressureTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    dir_ = fs::temp_directory_path() / "linuxcampam_psi_test";
+    fs::create_directories(dir_);
+    psi_ = (dir_ / "memory").string();
+    events_ = (dir_ / "memory.events").string();
+    writePsi(0.0, 0.0);
+    writeEvents(0, 0);
+  }
+  void TearDown() override { fs::remove_all(dir_); }
+
+  void writePsi(double some, double full) {
+    std::ofstream f(psi_);
+    f << "some avg10=" << some << " avg60=0.00 avg300=0.00 total=1000\n"
+      << "full avg10=" << full << " avg60=0.00 avg300=0.00 total=500\n";
+  }
+  void writeEvents(int high, int max) {
+    std::ofstream f(events_);
+    f << "low 0\nhigh " << high << "\nmax " << max << "\noom 0\noom_kill 0\n";
+  }
+
+  fs::path dir_;
+  std::string psi_;
+  std::string events_;
+};
+
+TEST(PsiParseTest, ParsesSomeAndFull) {
+  PsiSample s;
+  ASSERT_TRUE(parsePsi("some avg10=1.50 avg60=0.75 avg300=0.10 total=12345\n"
+                       "full avg10=0.25 avg60=0.00 avg300=0.00 total=678\n",
+                       s));
+  EXPECT_DOUBLE_EQ(s.some.avg10, 1.5);
+  EXPECT_DOUBLE_EQ(s.some.avg60, 0.75);
+  EXPECT_EQ(s.some.total, 12345u);
+  EXPECT_DOUBLE_EQ(s.full.avg10, 0.25);
+  EXPECT_EQ(s.full.total, 678u);
+}
+
+TEST(PsiParseTest, RejectsMissingOrGarbage) {
+  PsiSample s;
+  EXPECT_FALSE(parsePsi("", s));
+  EXPECT_FALSE(parsePsi("some avg10=abc\n", s));
+  // Old kernels: system file without a "full" line
+  EXPECT_TRUE(parsePsi("some avg10=2.00 avg60=0 avg300=0 total=1\n", s));
+  EXPECT_DOUBLE_EQ(s.full.avg10, 0.0);
+}
+
+TEST_F(MemoryPressureTest, LevelsFollowPsiThresholds) {
+  MemoryPressureMonitor mon(psi_, "", 10.0, 5.0);
+  ASSERT_TRUE(mon.available());
+  EXPECT_EQ(mon.poll(), PressureLevel::NONE);
+  writePsi(12.0, 0.0);
+  EXPECT_EQ(mon.poll(), PressureLevel::LOW);
+  writePsi(30.0, 6.0);
+  EXPECT_EQ(mon.poll(), PressureLevel::MEDIUM);
+  writePsi(40.0, 10.0);
+  EXPECT_EQ(mon.poll(), PressureLevel::CRITICAL);
+  writePsi(1.0, 0.0);
+  EXPECT_EQ(mon.poll(), PressureLevel::NONE);
+}
+
+TEST_F(MemoryPressureTest, CgroupEventsCountOnce) {
+  MemoryPressureMonitor mon(psi_, events_, 10.0, 5.0);
+  EXPECT_EQ(mon.poll(), PressureLevel::NONE);
+  writeEvents(1, 0);
+  EXPECT_EQ(mon.poll(), PressureLevel::MEDIUM);
+  EXPECT_EQ(mon.poll(), PressureLevel::NONE);
+  writeEvents(1, 3);
+  EXPECT_EQ(mon.poll(), PressureLevel::CRITICAL);
+}
+
+TEST_F(MemoryPressureTest, UnavailableWithoutPsi) {
+  MemoryPressureMonitor mon((dir_ / "missing").string(), "");
+  EXPECT_FALSE(mon.available());
+  EXPECT_EQ(mon.poll(), PressureLevel::NONE);
+}
+
+TEST_F(MemoryPressureTest, FindsCgroupV2EventsFile) {
+  fs::create_directories(dir_ / "root/system.slice/x.service");
+  std::ofstream(dir_ / "root/system.slice/x.service/memory.events") << "";
+  std::ofstream(dir_ / "cgroup") << "0::/system.slice/x.service\n";
+  EXPECT_EQ(cgroupMemoryEventsPath((dir_ / "cgroup").string(),
+                                   (dir_ / "root").string()),
+            (dir_ / "root/system.slice/x.service/memory.events").string());
+  std::ofstream(dir_ / "cgroup") << "12:memory:/user.slice\n";
+  EXPECT_EQ(cgroupMemoryEventsPath((dir_ / "cgroup").string(),
+                                   (dir_ / "root").string()),
+            "");
+}
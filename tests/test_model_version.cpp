@@ -1,20 +1,9 @@
-#include <filesystem>
+#include "model_registry.hpp"
+
 #include <gtest/gtest.h>
+#include <map>
 #include <string>
 
-namespace fs = std::filesystem;
-
-// Copy of getModelVersion function for testing
-inline std::string getModelVersion(const std::string &model_path) {
-  fs::path p(model_path);
-  std::string filename = p.stem().string();
-  const std::string prefix = "face_recognition_";
-  if (filename.rfind(prefix, 0) == 0) {
-    return filename.substr(prefix.length());
-  }
-  return filename;
-}
-
 TEST(ModelVersionTest, StandardSFaceModel) {
   EXPECT_EQ(getModelVersion(
                 "/etc/linuxcampam/models/face_recognition_sface_2021dec.onnx"),
@@ -42,3 +31,58 @@ TEST(ModelVersionTest, JustFilename) {
 TEST(ModelVersionTest, NoExtension) {
   EXPECT_EQ(getModelVersion("/path/face_recognition_test"), "test");
 }
+
+TEST(ModelRegistryTest, PrecisionFromFileName) {
+  EXPECT_EQ(parseModelPrecision("auto", "face_recognition_sface_2021dec.onnx"),
+            ModelPrecision::FP32);
+  EXPECT_EQ(
+      parseModelPrecision("auto", "face_recognition_sface_2021dec_int8.onnx"),
+      ModelPrecision::INT8);
+  EXPECT_EQ(parseModelPrecision("", "face_detection_yunet_2023mar_int8bq.onnx"),
+            ModelPrecision::INT8_BLOCK);
+  // Explicit setting wins over the file name
+  EXPECT_EQ(parseModelPrecision("int8", "custom.onnx"), ModelPrecision::INT8);
+}
+
+TEST(ModelRegistryTest, VersionIncludesPrecision) {
+  ModelSpec spec;
+  spec.path = "/m/face_recognition_sface_2021dec_int8.onnx";
+  spec.precision = ModelPrecision::INT8;
+  EXPECT_EQ(spec.version(), "sface_2021dec_int8");
+
+  spec.path = "/m/face_recognition_sface_quant.onnx";
+  EXPECT_EQ(spec.version(), "sface_quant_int8");
+
+  spec.precision = ModelPrecision::FP32;
+  EXPECT_EQ(spec.version(), "sface_quant");
+}
+
+TEST(ModelRegistryTest, FromConfig) {
+  std::map<std::string, std::string> ini = {
+      {"Models.face_recognition", "face_recognition_sface_2021dec_int8.onnx"},
+      {"Models.face_detection", "/opt/yunet.onnx"},
+      {"Models.face_detection_input_size", "320x240"},
+      {"Models.face_recognition_dim", "0"}};
+  auto get = [&ini](const std::string &key, const std::string &def) {
+    auto it = ini.find(key);
+    return it != ini.end() ? it->second : def;
+  };
+
+  ModelRegistry r = ModelRegistry::fromConfig(get, "/usr/share/models");
+  EXPECT_EQ(r.recognition.path,
+            "/usr/share/models/face_recognition_sface_2021dec_int8.onnx");
+  EXPECT_EQ(r.recognition.precision, ModelPrecision::INT8);
+  EXPECT_EQ(r.recognition.input_size, cv::Size(112, 112));
+  EXPECT_EQ(r.recognition.embedding_dim, 0);
+  EXPECT_EQ(r.detection.path, "/opt/yunet.onnx");
+  EXPECT_EQ(r.detection.input_size, cv::Size(320, 240));
+  EXPECT_TRUE(r.recognition_fast.path.empty());
+
+  // Defaults: bundled fp32 models
+  ini.clear();
+  r = ModelRegistry::fromConfig(get, "/usr/share/models");
+  EXPECT_EQ(r.detection.path,
+            "/usr/share/models/face_detection_yunet_2022mar.onnx");
+  EXPECT_EQ(r.recognition.version(), "sface_2021dec");
+  EXPECT_EQ(r.recognition.embedding_dim, 128);
+}
@@ -0,0 +1,88 @@
+#include "score_fusion.hpp"
+
+#include <cmath>
+#include <gtest/gtest.h>
+
+TEST(ScoreFusionTest, LikelihoodRatioSign) {
+  ScoreModel model;
+  EXPECT_GT(model.llr(model.genuine_mean), 0.0);
+  EXPECT_LT(model.llr(model.impostor_mean), 0.0);
+  EXPECT_GT(model.llr(0.5f), model.llr(0.4f));
+}
+
+TEST(ScoreFusionTest, WaldBounds) {
+  SequentialTest test(ScoreModel(), 1e-4, 1e-3);
+  EXPECT_NEAR(test.acceptBound(), std::log(0.999 / 1e-4), 1e-9);
+  EXPECT_NEAR(test.rejectBound(), std::log(1e-3 / 0.9999), 1e-9);
+}
+
+TEST(ScoreFusionTest, ClearMatchDecidesOnSecondFrame) {
+  SequentialTest test;
+  EXPECT_EQ(test.add(0.75f), FusionDecision::CONTINUE);
+  EXPECT_EQ(test.add(0.75f), FusionDecision::ACCEPT);
+  EXPECT_EQ(test.samples(), 2);
+
+  SequentialTest impostor;
+  EXPECT_EQ(impostor.add(0.0f), FusionDecision::CONTINUE);
+  EXPECT_EQ(impostor.add(0.0f), FusionDecision::REJECT);
+}
+
+TEST(ScoreFusionTest, BorderlineScoresAccumulate) {
+  SequentialTest test;
+  // Around the old single-frame threshold: not enough evidence alone
+  EXPECT_EQ(test.add(0.40f), FusionDecision::CONTINUE);
+  EXPECT_EQ(test.add(0.42f), FusionDecision::ACCEPT);
+  EXPECT_EQ(test.samples(), 2);
+
+  // Decision is final
+  EXPECT_EQ(test.add(0.0f), FusionDecision::ACCEPT);
+  EXPECT_EQ(test.samples(), 2);
+}
+
+TEST(ScoreFusionTest, FrameContributionIsClipped) {
+  SequentialTest test(ScoreModel(), 1e-4, 1e-3, 2.0);
+  EXPECT_EQ(test.add(0.9f), FusionDecision::CONTINUE);
+  EXPECT_DOUBLE_EQ(test.evidence(), 2.0);
+  EXPECT_EQ(test.add(-0.2f), FusionDecision::CONTINUE);
+  EXPECT_DOUBLE_EQ(test.evidence(), 0.0);
+}
+
+TEST(ScoreFusionTest, OneFrameNeverAccepts) {
+  // Even an explicit clip above the accept bound is capped below it
+  SequentialTest test(ScoreModel(), 1e-4, 1e-3, 100.0);
+  EXPECT_LT(test.maxFrameLLR(), test.acceptBound());
+  EXPECT_EQ(test.add(1.0f), FusionDecision::CONTINUE);
+  EXPECT_DOUBLE_EQ(test.evidence(), test.maxFrameLLR());
+}
+
+TEST(ScoreFusionTest, LowScoreNeverMovesTowardAccept) {
+  // genuine_std > impostor_std: the raw Gaussian ratio is positive far below
+  // the impostor mean (about +44 at -0.5)
+  ScoreModel model;
+  model.genuine_mean = 0.6f;
+  model.genuine_std = 0.2f;
+  model.impostor_mean = 0.05f;
+  model.impostor_std = 0.05f;
+  ASSERT_TRUE(model.valid());
+  EXPECT_LT(model.llr(-0.5f), 0.0);
+  EXPECT_DOUBLE_EQ(model.llr(-0.5f), model.llr(model.impostor_mean));
+
+  SequentialTest test(model, 1e-4, 1e-3);
+  for (float score : {-0.5f, -1.0f, 0.0f, 0.04f}) {
+    double before = test.evidence();
+    EXPECT_NE(test.add(score), FusionDecision::ACCEPT);
+    EXPECT_LE(test.evidence(), before);
+  }
+  EXPECT_EQ(test.decision(), FusionDecision::REJECT);
+}
+
+TEST(ScoreFusionTest, RejectsBadCalibration) {
+  EXPECT_TRUE(ScoreModel().valid());
+  ScoreModel swapped;
+  swapped.genuine_mean = 0.05f;
+  swapped.impostor_mean = 0.60f;
+  EXPECT_FALSE(swapped.valid());
+  ScoreModel flat;
+  flat.genuine_std = 0.0f;
+  EXPECT_FALSE(flat.valid());
+}
@@ -0,0 +1,94 @@
+#include "thread_pool.hpp"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+TEST(ThreadPoolTest, ParallelForCoversRangeOnce) {
+  ThreadPool pool(3);
+  std::vector<std::atomic<int>> hits(1000);
+  pool.parallelFor(1000, [&](int begin, int end) {
+    for (int i = begin; i < end; i++)
+      hits[i]++;
+  });
+  for (const auto &h : hits)
+    EXPECT_EQ(h.load(), 1);
+}
+
+TEST(ThreadPoolTest, NestedParallelForDoesNotDeadlock) {
+  ThreadPool pool(2);
+  std::atomic<int> total{0};
+  pool.parallelFor(8, [&](int begin, int end) {
+    for (int i = begin; i < end; i++) {
+      pool.parallelFor(100, [&](int b, int e) { total += e - b; });
+    }
+  });
+  EXPECT_EQ(total.load(), 800);
+}
+
+TEST(ThreadPoolTest, ExceptionReachesCaller) {
+  ThreadPool pool(2);
+  EXPECT_THROW(pool.parallelFor(64,
+                                [](int begin, int) {
+                                  if (begin == 0)
+                                    throw std::runtime_error("layer failed");
+                                }),
+               std::runtime_error);
+}
+
+TEST(ThreadPoolTest, ConcurrencyLimitsThreads) {
+  ThreadPool pool(3);
+  EXPECT_EQ(pool.concurrency(), 4);
+  pool.setConcurrency(1);
+  std::set<std::thread::id> ids;
+  std::mutex m;
+  pool.parallelFor(100, [&](int, int) {
+    std::lock_guard<std::mutex> lock(m);
+    ids.insert(std::this_thread::get_id());
+  });
+  EXPECT_EQ(ids.size(), 1u);
+  EXPECT_EQ(*ids.begin(), std::this_thread::get_id());
+  pool.setConcurrency(0);
+  EXPECT_EQ(pool.concurrency(), 4);
+}
+
+TEST(ThreadPoolTest, SubmitRunsOnWorker) {
+  ThreadPool pool(2);
+  int index = -1;
+  pool.submit([&] { index = ThreadPool::workerIndex(); }).get();
+  EXPECT_GE(index, 1);
+  EXPECT_EQ(ThreadPool::workerIndex(), 0);
+}
+
+TEST(ThreadPoolTest, HighPriorityRunsBeforeBackground) {
+  ThreadPool pool(1);
+  std::promise<void> release;
+  std::shared_future<void> gate = release.get_future().share();
+  auto blocker = pool.submit([gate] { gate.wait(); });
+
+  std::mutex m;
+  std::string order;
+  std::future<void> low, high;
+  {
+    ThreadPool::PriorityScope scope(ThreadPool::Priority::LOW);
+    low = pool.submit([&] {
+      std::lock_guard<std::mutex> lock(m);
+      order += "L";
+    });
+  }
+  {
+    ThreadPool::PriorityScope scope(ThreadPool::Priority::HIGH);
+    high = pool.submit([&] {
+      std::lock_guard<std::mutex> lock(m);
+      order += "H";
+    });
+  }
+  release.set_value();
+  blocker.get();
+  low.get();
+  high.get();
+  EXPECT_EQ(order, "HL");
+}